@@ -0,0 +1,65 @@
+#include "AllocationCounter.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+
+std::atomic<unsigned long> AllocationCount { 0 };
+std::atomic<unsigned long> AllocatedBytes { 0 };
+
+void* counted_allocation(std::size_t size)
+{
+    AllocationCount.fetch_add(1, std::memory_order_relaxed);
+    AllocatedBytes.fetch_add(size, std::memory_order_relaxed);
+
+    if (auto* p = std::malloc(0 == size ? 1 : size))
+        return p;
+
+    throw std::bad_alloc();
+}
+
+}
+
+unsigned long allocation_count() noexcept
+{
+    return AllocationCount.load(std::memory_order_relaxed);
+}
+
+unsigned long allocated_bytes() noexcept
+{
+    return AllocatedBytes.load(std::memory_order_relaxed);
+}
+
+void* operator new(std::size_t size)
+{
+    return counted_allocation(size);
+}
+
+void* operator new[](std::size_t size)
+{
+    return counted_allocation(size);
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
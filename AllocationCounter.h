@@ -0,0 +1,13 @@
+#pragma once
+
+// Replaces the global operator new and delete with versions which count
+// the heap allocations, to check and report that the hot paths make none.
+//
+// AllocationCounter.cpp is compiled into the test and benchmark
+// executables only, never into the library.
+
+/// @brief Number of allocations made through operator new so far.
+unsigned long allocation_count() noexcept;
+
+/// @brief Total size of the allocations made so far, in bytes.
+unsigned long allocated_bytes() noexcept;
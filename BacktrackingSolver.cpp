@@ -1,83 +1,67 @@
 #include "BacktrackingSolver.h"
 
+#include "DigitMask.h"
+#include "GridLayout.h"
+
 #include <cassert>
 #include <cstddef>
+#include <utility>
 
-BacktrackingSolver::BacktrackingSolver(SudokuGrid& grid)
-    : Grid_(&grid)
+template <unsigned Side>
+BasicBacktrackingSolver<Side>::BasicBacktrackingSolver(Strategy strategy) noexcept
+    : Strategy_(strategy)
 { }
 
-namespace
-{
+template <unsigned Side>
+BasicBacktrackingSolver<Side>::BasicBacktrackingSolver(grid_type& grid, Strategy strategy)
+    :
+      BasicSolver<Side>(grid),
+      Strategy_(strategy)
+{ }
 
-bool row_contains_value(
-        const SudokuGrid& grid,
-        char value,
-        size_t row)
+template <unsigned Side>
+void BasicBacktrackingSolver<Side>::reset(grid_type& grid)
 {
-    for (unsigned c = 0; c < grid.columns(); ++c)
-    {
-        if (value == grid[row][c])
-            return true;
-    }
-
-    return false;
+    BasicSolver<Side>::reset(grid);
+    this->Nodes_ = 0;
+    this->Backtracks_ = 0;
 }
 
-bool column_contains_value(
-        const SudokuGrid& grid,
-        char value,
-        size_t column)
+namespace
 {
-    for (unsigned r = 0; r < grid.rows(); ++r)
-    {
-        if (value == grid[r][column])
-            return true;
-    }
 
-    return false;
-}
+struct SearchCounters
+{
+    unsigned long Nodes = 0;
+    unsigned long Backtracks = 0;
+};
 
-bool subgrid_contains_value(
-        const SudokuGrid& grid,
+/// @brief Whether @p value fits in @p cell: none of its peers holds it.
+template <typename Grid>
+bool is_possible(
+        const Grid& grid,
         char value,
-        size_t row,
-        size_t column)
+        unsigned cell)
 {
-    constexpr auto subgridSideLength = 3;
-    const auto rowStart = subgridSideLength * (row / subgridSideLength);
-    const auto rowEnd = rowStart + subgridSideLength;
+    using layout_type = BasicGridLayout<Grid::sideLength()>;
 
-    const auto columnStart = subgridSideLength * (column / subgridSideLength);
-    const auto columnEnd = columnStart + subgridSideLength;
-
-    for (unsigned r = rowStart; r < rowEnd; ++r)
+    const auto* values = &grid[0][0];
+    const auto* peers = layout_type::peers(cell);
+    for (unsigned i = 0; i < layout_type::PeerCount; ++i)
     {
-        for (unsigned c = columnStart; c < columnEnd; ++c)
-        {
-            if (value == grid[r][c])
-                return true;
-        }
+        if (value == values[peers[i]])
+            return false;
     }
 
-    return false;
-}
-
-bool is_possible(
-        const SudokuGrid& grid,
-        char value,
-        size_t row,
-        size_t column)
-{
-    return  !row_contains_value(grid, value, row) &&
-            !column_contains_value(grid, value, column) &&
-            !subgrid_contains_value(grid, value, row, column);
+    return true;
 }
 
+template <typename Grid>
 void solve_impl(
-        SudokuGrid& grid,
+        Grid& grid,
         const unsigned missing,
         unsigned& inserted,
+        SearchCounters& counters,
         const unsigned rowStart = 0)
 {
     assert(rowStart < grid.rows());
@@ -87,18 +71,20 @@ void solve_impl(
         {
             if (is_empty(grid[r][c]))
             {
-                for (SudokuGrid::value_type i = 1; i <= static_cast<char>(SudokuGridSide); ++i)
+                for (typename Grid::value_type i = 1; i <= static_cast<char>(Grid::sideLength()); ++i)
                 {
-                    if (is_possible(grid, i, r, c))
+                    if (is_possible(grid, i, r * grid.columns() + c))
                     {
                         grid[r][c] = i;
                         ++inserted;
+                        ++counters.Nodes;
 
-                        solve_impl(grid, missing, inserted, r);
+                        solve_impl(grid, missing, inserted, counters, r);
                         if (inserted < missing)
                         {
                             grid[r][c] = 0;
                             --inserted;
+                            ++counters.Backtracks;
                         }
                         else
                         {
@@ -114,32 +100,222 @@ void solve_impl(
     return;
 }
 
-unsigned count_missing(const SudokuGrid& grid)
+/// @brief Backtracking on the empty cell with the fewest candidates.
+///
+/// The digits of each row, column and subgrid are kept in masks, so that
+/// the candidates of a cell are a couple of bitwise operations away and a
+/// placement (or its removal) only updates three masks.
+template <unsigned Side>
+class MrvSearch final
 {
-    unsigned missing = 0;
-    for (unsigned r = 0; r < grid.rows(); ++r)
+public:
+    MrvSearch(BasicSudokuGrid<Side>& grid, SearchCounters& counters)
+        :
+          Grid_(grid),
+          Counters_(counters)
     {
-        for (unsigned c = 0; c < grid.columns(); ++c)
+        for (unsigned r = 0; r < Side; ++r)
         {
-            missing += static_cast<char>(0) == grid[r][c];
+            for (unsigned c = 0; c < Side; ++c)
+            {
+                const Cell cell {
+                    static_cast<unsigned char>(r),
+                    static_cast<unsigned char>(c),
+                    static_cast<unsigned char>(layout_type::subgrid(r * Side + c)) };
+
+                const auto value = grid[r][c];
+                if (is_empty(value))
+                {
+                    this->EmptyCells_[this->EmptyCount_++] = cell;
+                }
+                else if (this->candidates(cell).contains(value))
+                {
+                    this->set(cell, value);
+                }
+                else
+                {
+                    // The digit is already in the row, column or subgrid.
+                    this->Consistent_ = false;
+                }
+            }
         }
     }
 
-    return missing;
+    /// @brief Search until @p limit solutions are found.
+    ///
+    /// If the limit is reached, the grid holds the last solution found,
+    /// otherwise it is left as it was.
+    /// @return The number of solutions found (at most @p limit).
+    unsigned long solve(unsigned long limit)
+    {
+        assert(limit > 0);
+
+        this->Limit_ = limit;
+        this->Solutions_ = 0;
+        if (this->Consistent_)
+        {
+            this->search(this->EmptyCount_);
+        }
+
+        return this->Solutions_;
+    }
+
+private:
+    using mask_type = BasicDigitMask<Side>;
+    using layout_type = BasicGridLayout<Side>;
+
+    struct Cell
+    {
+        unsigned char Row;
+        unsigned char Column;
+        unsigned char Subgrid;
+    };
+
+    mask_type candidates(Cell cell) const noexcept
+    {
+        const auto used = this->Rows_[cell.Row] | this->Columns_[cell.Column] | this->Subgrids_[cell.Subgrid];
+        return and_not(mask_type::all(), used);
+    }
+
+    void set(Cell cell, unsigned digit) noexcept
+    {
+        const auto mask = mask_type::single(digit);
+        this->Rows_[cell.Row] |= mask;
+        this->Columns_[cell.Column] |= mask;
+        this->Subgrids_[cell.Subgrid] |= mask;
+    }
+
+    void unset(Cell cell, unsigned digit) noexcept
+    {
+        const auto mask = mask_type::single(digit);
+        this->Rows_[cell.Row].erase(mask);
+        this->Columns_[cell.Column].erase(mask);
+        this->Subgrids_[cell.Subgrid].erase(mask);
+    }
+
+    /// @brief Fill the first @p remaining cells of EmptyCells_.
+    /// @return true once the solution limit is reached.
+    bool search(unsigned remaining)
+    {
+        if (0 == remaining)
+            return ++(this->Solutions_) >= this->Limit_;
+
+        unsigned best = 0;
+        unsigned bestCount = Side + 1;
+        mask_type bestCandidates;
+        for (unsigned i = 0; i < remaining && bestCount > 1; ++i)
+        {
+            const auto candidates = this->candidates(this->EmptyCells_[i]);
+            const auto count = candidates.count();
+            if (count < bestCount)
+            {
+                best = i;
+                bestCount = count;
+                bestCandidates = candidates;
+            }
+        }
+
+        if (0 == bestCount)
+            return false;
+
+        // Move the chosen cell out of the range still to be filled.
+        std::swap(this->EmptyCells_[best], this->EmptyCells_[remaining - 1]);
+        const auto cell = this->EmptyCells_[remaining - 1];
+
+        for (auto digits = bestCandidates; !digits.empty(); )
+        {
+            const auto digit = digits.pop_lowest();
+            this->set(cell, digit);
+            this->Grid_[cell.Row][cell.Column] = static_cast<char>(digit);
+            ++this->Counters_.Nodes;
+
+            if (this->search(remaining - 1))
+                return true;
+
+            this->unset(cell, digit);
+            this->Grid_[cell.Row][cell.Column] = 0;
+            ++this->Counters_.Backtracks;
+        }
+
+        return false;
+    }
+
+    BasicSudokuGrid<Side>& Grid_;
+    SearchCounters& Counters_;
+
+    mask_type Rows_[Side];
+    mask_type Columns_[Side];
+    mask_type Subgrids_[Side];
+
+    Cell EmptyCells_[Side * Side] {};
+    unsigned EmptyCount_ = 0;
+    bool Consistent_ = true;
+
+    unsigned long Limit_ = 1;
+    unsigned long Solutions_ = 0;
+};
+
+}
+
+template <unsigned Side>
+bool BasicBacktrackingSolver<Side>::exec()
+{
+    SearchCounters counters;
+    bool solved = false;
+
+    switch (this->Strategy_)
+    {
+    case Strategy::RowMajor:
+    {
+        const auto missing = this->NumberOfMissingDigits_;
+        unsigned inserted = 0;
+        solve_impl(*this->Grid_, missing, inserted, counters);
+        solved = inserted == missing;
+        break;
+    }
+    case Strategy::MinimumRemainingValues:
+        solved = 0 != MrvSearch<Side>(*this->Grid_, counters).solve(1);
+        break;
+    }
+
+    this->Nodes_ = counters.Nodes;
+    this->Backtracks_ = counters.Backtracks;
+    this->InsertedDigits_ = solved ? this->NumberOfMissingDigits_ : 0;
+    return solved;
 }
 
+template <unsigned Side>
+typename BasicBacktrackingSolver<Side>::Strategy BasicBacktrackingSolver<Side>::strategy() const noexcept
+{
+    return this->Strategy_;
 }
 
-bool BacktrackingSolver::exec()
+template <unsigned Side>
+unsigned long BasicBacktrackingSolver<Side>::nodes() const noexcept
 {
-    const auto missing = count_missing(*this->Grid_);
-    unsigned inserted = 0;
-    solve_impl(*this->Grid_, missing, inserted);
-    this->InsertedDigits_ = missing;
-    return true;
+    return this->Nodes_;
 }
 
-bool BacktrackingSolver::insertedDigits() const
+template <unsigned Side>
+unsigned long BasicBacktrackingSolver<Side>::backtracks() const noexcept
 {
-    return this->InsertedDigits_;
+    return this->Backtracks_;
 }
+
+template <unsigned Side>
+unsigned long count_solutions(const BasicSudokuGrid<Side>& grid, unsigned long limit)
+{
+    auto copy = grid;
+    SearchCounters counters;
+    return MrvSearch<Side>(copy, counters).solve(limit);
+}
+
+template class BasicBacktrackingSolver<4>;
+template class BasicBacktrackingSolver<9>;
+template class BasicBacktrackingSolver<16>;
+template class BasicBacktrackingSolver<25>;
+
+template unsigned long count_solutions(const BasicSudokuGrid<4>&, unsigned long);
+template unsigned long count_solutions(const BasicSudokuGrid<9>&, unsigned long);
+template unsigned long count_solutions(const BasicSudokuGrid<16>&, unsigned long);
+template unsigned long count_solutions(const BasicSudokuGrid<25>&, unsigned long);
@@ -1,15 +1,74 @@
 #pragma once
 
-#include "SudokuGrid.h"
+#include "Solver.h"
 
-class BacktrackingSolver
+template <unsigned Side>
+class BasicBacktrackingSolver : public BasicSolver<Side>
 {
 public:
-    explicit BacktrackingSolver(SudokuGrid& grid);
-    bool exec();
+    using grid_type = typename BasicSolver<Side>::grid_type;
+
+    /// @brief How the next empty cell to fill is chosen.
+    enum class Strategy
+    {
+        /// The first empty cell in row-major order. Each digit is checked by
+        /// scanning its row, column and subgrid.
+        RowMajor,
+
+        /// The empty cell with the fewest candidates. Candidates come from
+        /// row, column and subgrid digit masks updated at each placement.
+        MinimumRemainingValues
+    };
+
+    /// @brief A solver to be reset() for each grid.
+    explicit BasicBacktrackingSolver(Strategy strategy = Strategy::RowMajor) noexcept;
+
+    explicit BasicBacktrackingSolver(grid_type& grid, Strategy strategy = Strategy::RowMajor);
+
+    void reset(grid_type& grid) override;
+    bool exec() override;
+
+    Strategy strategy() const noexcept;
+
+    /// @brief Number of digits tentatively placed by the last exec().
+    unsigned long nodes() const noexcept;
+
+    /// @brief Number of tentative digits taken back by the last exec().
+    unsigned long backtracks() const noexcept;
 
-    bool insertedDigits() const;
 private:
-    SudokuGrid* Grid_ = nullptr;
-    unsigned InsertedDigits_ = 0;
+    Strategy Strategy_ = Strategy::RowMajor;
+    unsigned long Nodes_ = 0;
+    unsigned long Backtracks_ = 0;
 };
+
+using BacktrackingSolver = BasicBacktrackingSolver<9>;
+
+/// @brief The minimum remaining values backtracking solver, as a type:
+/// for code which builds solvers from their type alone, such as BatchSolver.
+template <unsigned Side>
+class BasicMrvBacktrackingSolver final : public BasicBacktrackingSolver<Side>
+{
+public:
+    using grid_type = typename BasicBacktrackingSolver<Side>::grid_type;
+
+    BasicMrvBacktrackingSolver() noexcept
+        : BasicBacktrackingSolver<Side>(BasicBacktrackingSolver<Side>::Strategy::MinimumRemainingValues)
+    { }
+
+    explicit BasicMrvBacktrackingSolver(grid_type& grid)
+        : BasicBacktrackingSolver<Side>(grid, BasicBacktrackingSolver<Side>::Strategy::MinimumRemainingValues)
+    { }
+};
+
+using MrvBacktrackingSolver = BasicMrvBacktrackingSolver<9>;
+
+/// @brief Count the solutions of @p grid, but stop as soon as @p limit
+/// (at least 1) of them are found.
+///
+/// The search is the minimum remaining values one, and @p grid is not
+/// changed. count_solutions(grid, 2) == 1 tells that a grid has a unique
+/// solution.
+/// @return The number of solutions, or @p limit if there are at least as many.
+template <unsigned Side>
+unsigned long count_solutions(const BasicSudokuGrid<Side>& grid, unsigned long limit);
@@ -0,0 +1,78 @@
+#include "BatchSolver.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+namespace
+{
+
+unsigned default_thread_count() noexcept
+{
+    const auto hardwareThreads = std::thread::hardware_concurrency();
+    return std::max(hardwareThreads, 1U);
+}
+
+}
+
+BatchSolver::BatchSolver(unsigned threadCount, unsigned chunkSize)
+    :
+      ThreadCount_(0 == threadCount ? default_thread_count() : threadCount),
+      ChunkSize_(std::max(chunkSize, 1U))
+{ }
+
+unsigned BatchSolver::threadCount() const noexcept
+{
+    return this->ThreadCount_;
+}
+
+unsigned BatchSolver::chunkSize() const noexcept
+{
+    return this->ChunkSize_;
+}
+
+void BatchSolver::run(void* grids, BatchResult* results, std::size_t count, solve_function solve, const void* options) const
+{
+    parallel_for(count, this->ChunkSize_, this->ThreadCount_, [grids, results, solve, options](std::size_t first, std::size_t last)
+    {
+        solve(grids, results, first, last, options);
+    });
+}
+
+void parallel_for(std::size_t count, std::size_t chunkSize, unsigned threadCount, range_function body, const void* context)
+{
+    std::atomic<std::size_t> nextChunk { 0 };
+    chunkSize = std::max<std::size_t>(chunkSize, 1);
+
+    const auto worker = [&nextChunk, chunkSize, count, body, context]()
+    {
+        for (;;)
+        {
+            const auto first = nextChunk.fetch_add(chunkSize, std::memory_order_relaxed);
+            if (first >= count)
+                return;
+
+            body(first, std::min(first + chunkSize, count), context);
+        }
+    };
+
+    // Don't spawn threads which would have nothing to do.
+    const auto chunkCount = (count + chunkSize - 1) / chunkSize;
+    const auto threads = 0 == threadCount ? default_thread_count() : threadCount;
+    const auto helperCount = std::min<std::size_t>(threads, chunkCount) - (0 != chunkCount);
+
+    std::vector<std::thread> helpers;
+    helpers.reserve(helperCount);
+    for (std::size_t t = 0; t < helperCount; ++t)
+    {
+        helpers.emplace_back(worker);
+    }
+
+    // The calling thread is a worker, too.
+    worker();
+
+    for (auto& helper : helpers)
+    {
+        helper.join();
+    }
+}
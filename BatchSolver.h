@@ -0,0 +1,130 @@
+#pragma once
+
+#include "SudokuGrid.h" // IWYU pragma: keep
+
+#include <cstddef>
+#include <vector>
+
+/// @brief Runs [first, last) ranges of a parallel loop: @p context is the
+/// loop body, type-erased.
+using range_function = void (*)(std::size_t first, std::size_t last, const void* context);
+
+/// @brief Run a loop over [0, @p count) on a pool of threads.
+///
+/// The indices are handed out in chunks of @p chunkSize consecutive ones
+/// through a shared atomic counter, so that faster threads keep taking work
+/// until the loop is done. The calling thread is one of the @p threadCount
+/// threads (one per hardware thread if 0), and no more threads are started
+/// than there are chunks.
+void parallel_for(std::size_t count, std::size_t chunkSize, unsigned threadCount, range_function body, const void* context);
+
+/// @brief parallel_for() calling @p body(first, last) for each chunk.
+template <typename Body>
+void parallel_for(std::size_t count, std::size_t chunkSize, unsigned threadCount, const Body& body)
+{
+    parallel_for(count, chunkSize, threadCount, [](std::size_t first, std::size_t last, const void* context)
+    {
+        (*static_cast<const Body*>(context))(first, last);
+    }, &body);
+}
+
+struct BatchResult
+{
+    bool Solved = false;
+    unsigned InsertedDigits = 0;
+};
+
+/// @brief Solves many grids in place on a pool of worker threads.
+///
+/// Grids are handed out to the workers in chunks of consecutive puzzles
+/// (see parallel_for()). Each worker runs its own solver, reset()
+/// for each grid of its chunk: no solver state is shared between threads.
+class BatchSolver final
+{
+public:
+    /// @param threadCount Number of worker threads (the calling thread
+    ///                    included). If 0, one per hardware thread is used.
+    /// @param chunkSize Number of consecutive grids a worker takes at once.
+    explicit BatchSolver(unsigned threadCount = 0, unsigned chunkSize = 64);
+
+    /// @brief Solve @p count grids of SolverType::grid_type in place.
+    template <typename SolverType>
+    std::vector<BatchResult> solve(typename SolverType::grid_type* grids, std::size_t count) const
+    {
+        std::vector<BatchResult> results(count);
+        this->run(grids, results.data(), count, &BatchSolver::solve_range<SolverType>, nullptr);
+        return results;
+    }
+
+    /// @brief Solve @p count grids of SolverType::grid_type in place, with
+    /// solvers built as SolverType(options).
+    template <typename SolverType, typename Options>
+    std::vector<BatchResult> solve(typename SolverType::grid_type* grids, std::size_t count, const Options& options) const
+    {
+        std::vector<BatchResult> results(count);
+        this->run(grids, results.data(), count, &BatchSolver::solve_range_with<SolverType, Options>, &options);
+        return results;
+    }
+
+    /// @brief Solve @p count grids in place, handing whole chunks to
+    /// @p solver, e.g. a LockstepSolver: the chunk size is best a multiple
+    /// of its group size. The workers share @p solver, whose const solve()
+    /// must be safe to call from several threads.
+    template <typename ChunkSolver>
+    std::vector<BatchResult> solve_chunks(const ChunkSolver& solver, typename ChunkSolver::grid_type* grids, std::size_t count) const
+    {
+        std::vector<BatchResult> results(count);
+        this->run(grids, results.data(), count, &BatchSolver::solve_chunk<ChunkSolver>, &solver);
+        return results;
+    }
+
+    unsigned threadCount() const noexcept;
+    unsigned chunkSize() const noexcept;
+
+private:
+    // Solves the grids [first, last) of the array: the grid and options
+    // types are erased, so that run() needn't be a template.
+    using solve_function = void (*)(void* grids, BatchResult* results, std::size_t first, std::size_t last, const void* options);
+
+    template <typename SolverType>
+    static void solve_range(void* grids, BatchResult* results, std::size_t first, std::size_t last, const void*)
+    {
+        SolverType solver;
+        for (auto i = first; i < last; ++i)
+        {
+            solver.reset(static_cast<typename SolverType::grid_type*>(grids)[i]);
+            results[i] = make_result(solver);
+        }
+    }
+
+    template <typename SolverType, typename Options>
+    static void solve_range_with(void* grids, BatchResult* results, std::size_t first, std::size_t last, const void* options)
+    {
+        SolverType solver(*static_cast<const Options*>(options));
+        for (auto i = first; i < last; ++i)
+        {
+            solver.reset(static_cast<typename SolverType::grid_type*>(grids)[i]);
+            results[i] = make_result(solver);
+        }
+    }
+
+    template <typename ChunkSolver>
+    static void solve_chunk(void* grids, BatchResult* results, std::size_t first, std::size_t last, const void* solver)
+    {
+        static_cast<const ChunkSolver*>(solver)->solve(static_cast<typename ChunkSolver::grid_type*>(grids) + first, results + first, last - first);
+    }
+
+    template <typename SolverType>
+    static BatchResult make_result(SolverType& solver)
+    {
+        BatchResult result;
+        result.Solved = solver.exec();
+        result.InsertedDigits = solver.insertedDigits();
+        return result;
+    }
+
+    void run(void* grids, BatchResult* results, std::size_t count, solve_function solve, const void* options) const;
+
+    unsigned ThreadCount_ = 1;
+    unsigned ChunkSize_ = 1;
+};
@@ -0,0 +1,279 @@
+#include "CandidateBoard.h"
+
+#include <cassert>
+#include <initializer_list>
+
+template <unsigned Side>
+BasicCandidateBoard<Side>::BasicCandidateBoard(grid_type& grid)
+{
+    this->reset(grid);
+}
+
+template <unsigned Side>
+void BasicCandidateBoard<Side>::reset(grid_type& grid) noexcept
+{
+    this->Grid_ = &grid;
+    this->TrailSize_ = 0;
+
+    for (auto& digitPositions : this->Positions_)
+    {
+        for (auto& positions : digitPositions)
+        {
+            positions.clear();
+        }
+    }
+
+    for (auto& digits : this->PlacedDigits_)
+    {
+        digits.clear();
+    }
+
+    for (auto& word : this->SingleCells_)
+    {
+        word = 0;
+    }
+
+    // The givens of each unit, in a single pass over the cells.
+    const auto* values = &grid[0][0];
+    bool consistent = true;
+    for (unsigned cell = 0; cell < CellCount; ++cell)
+    {
+        const auto value = values[cell];
+        if (is_empty(value))
+            continue;
+
+        for (const auto unit : { row_unit(cell), column_unit(cell), subgrid_unit(cell) })
+        {
+            consistent = consistent && !this->PlacedDigits_[unit].contains(value);
+            this->PlacedDigits_[unit].insert(value);
+        }
+    }
+
+    // Two equal givens in a unit: there's nothing to solve.
+    this->Contradiction_ = !consistent;
+
+    for (unsigned cell = 0; cell < CellCount; ++cell)
+    {
+        auto& candidates = this->Candidates_[cell / Side][cell % Side];
+        candidates.clear();
+        if (!is_empty(values[cell]))
+            continue;
+
+        const auto forbiddenDigits = this->PlacedDigits_[row_unit(cell)] | this->PlacedDigits_[column_unit(cell)] | this->PlacedDigits_[subgrid_unit(cell)];
+        candidates = and_not(candidate_mask::all(), forbiddenDigits);
+        this->Contradiction_ = this->Contradiction_ || candidates.empty();
+        this->set_single(cell, 1 == candidates.count());
+
+        for (auto remaining = candidates; !remaining.empty(); )
+        {
+            auto* positions = this->Positions_[remaining.pop_lowest() - 1];
+            positions[row_unit(cell)].insert(cell % Side + 1);
+            positions[column_unit(cell)].insert(cell / Side + 1);
+            positions[subgrid_unit(cell)].insert(subgrid_position(cell) + 1);
+        }
+    }
+
+    // Every unit is new to the techniques.
+    for (auto& version : this->UnitVersions_)
+    {
+        version = ++(this->Clock_);
+    }
+}
+
+template <unsigned Side>
+const typename BasicCandidateBoard<Side>::candidate_grid& BasicCandidateBoard<Side>::candidateGrid() const noexcept
+{
+    return this->Candidates_;
+}
+
+template <unsigned Side>
+bool BasicCandidateBoard<Side>::contradiction() const noexcept
+{
+    return this->Contradiction_;
+}
+
+template <unsigned Side>
+bool BasicCandidateBoard<Side>::find_single(unsigned& cell) const noexcept
+{
+    for (unsigned word = 0; word < SingleWordCount; ++word)
+    {
+        if (0 != this->SingleCells_[word])
+        {
+            cell = 64 * word + detail::count_trailing_zeros(this->SingleCells_[word]);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+template <unsigned Side>
+void BasicCandidateBoard<Side>::set_single(unsigned cell, bool single) noexcept
+{
+    const auto bit = std::uint64_t(1) << (cell % 64);
+    auto& word = this->SingleCells_[cell / 64];
+    word = single ? (word | bit) : (word & ~bit);
+}
+
+template <unsigned Side>
+void BasicCandidateBoard<Side>::touch(unsigned cell) noexcept
+{
+    this->UnitVersions_[row_unit(cell)] = ++(this->Clock_);
+    this->UnitVersions_[column_unit(cell)] = ++(this->Clock_);
+    this->UnitVersions_[subgrid_unit(cell)] = ++(this->Clock_);
+}
+
+template <unsigned Side>
+void BasicCandidateBoard<Side>::erase_positions(unsigned cell, candidate_mask digits) noexcept
+{
+    const auto row = row_unit(cell);
+    const auto column = column_unit(cell);
+    const auto subgrid = subgrid_unit(cell);
+    const auto rowPosition = candidate_mask::single(cell % Side + 1);
+    const auto columnPosition = candidate_mask::single(cell / Side + 1);
+    const auto subgridPosition = candidate_mask::single(subgrid_position(cell) + 1);
+
+    for (auto remaining = digits; !remaining.empty(); )
+    {
+        auto* positions = this->Positions_[remaining.pop_lowest() - 1];
+        positions[row].erase(rowPosition);
+        positions[column].erase(columnPosition);
+        positions[subgrid].erase(subgridPosition);
+    }
+}
+
+template <unsigned Side>
+void BasicCandidateBoard<Side>::insert_positions(unsigned cell, candidate_mask digits) noexcept
+{
+    const auto row = row_unit(cell);
+    const auto column = column_unit(cell);
+    const auto subgrid = subgrid_unit(cell);
+    const auto rowPosition = candidate_mask::single(cell % Side + 1);
+    const auto columnPosition = candidate_mask::single(cell / Side + 1);
+    const auto subgridPosition = candidate_mask::single(subgrid_position(cell) + 1);
+
+    for (auto remaining = digits; !remaining.empty(); )
+    {
+        auto* positions = this->Positions_[remaining.pop_lowest() - 1];
+        positions[row] |= rowPosition;
+        positions[column] |= columnPosition;
+        positions[subgrid] |= subgridPosition;
+    }
+}
+
+template <unsigned Side>
+unsigned BasicCandidateBoard<Side>::eliminate(unsigned cell, candidate_mask digits)
+{
+    auto& candidates = this->Candidates_[cell / Side][cell % Side];
+    const auto removed = candidates & digits;
+    if (removed.empty())
+        return 0;
+
+    this->push_change(cell, false, removed);
+    candidates.erase(removed);
+    this->touch(cell);
+    this->set_single(cell, 1 == candidates.count());
+    this->erase_positions(cell, removed);
+
+    // The cell is still empty, but no digit fits.
+    this->Contradiction_ = this->Contradiction_ || candidates.empty();
+
+    return removed.count();
+}
+
+template <unsigned Side>
+void BasicCandidateBoard<Side>::place(unsigned cell, unsigned digit)
+{
+    const auto row = cell / Side;
+    const auto column = cell % Side;
+
+    // This cell is now fixed.
+    this->push_change(cell, true, this->Candidates_[row][column]);
+    this->erase_positions(cell, this->Candidates_[row][column]);
+    this->Candidates_[row][column].clear();
+    (*this->Grid_)[row][column] = static_cast<typename grid_type::value_type>(digit);
+    this->touch(cell);
+    this->set_single(cell, false);
+
+    this->PlacedDigits_[row_unit(cell)].insert(digit);
+    this->PlacedDigits_[column_unit(cell)].insert(digit);
+    this->PlacedDigits_[subgrid_unit(cell)].insert(digit);
+
+    const auto digitMask = candidate_mask::single(digit);
+    const auto* peers = layout_type::peers(cell);
+    for (unsigned i = 0; i < layout_type::PeerCount; ++i)
+    {
+        this->eliminate(peers[i], digitMask);
+    }
+}
+
+template <unsigned Side>
+void BasicCandidateBoard<Side>::apply(const deduction_type& deduction)
+{
+    if (deduction.Contradiction)
+    {
+        this->Contradiction_ = true;
+        return;
+    }
+
+    if (deduction.placement())
+    {
+        this->place(deduction.Cells[0], deduction.Digits.lowest());
+        return;
+    }
+
+    for (const auto& elimination : deduction.Eliminations)
+    {
+        this->eliminate(elimination.Cell, elimination.Digits);
+    }
+}
+
+template <unsigned Side>
+void BasicCandidateBoard<Side>::record(Change* trail) noexcept
+{
+    this->Trail_ = trail;
+    this->TrailSize_ = 0;
+}
+
+template <unsigned Side>
+void BasicCandidateBoard<Side>::push_change(unsigned cell, bool placement, candidate_mask digits) noexcept
+{
+    if (nullptr == this->Trail_)
+        return;
+
+    assert(this->TrailSize_ < MaxChanges);
+    this->Trail_[this->TrailSize_++] = Change { static_cast<std::uint16_t>(cell), placement, digits };
+}
+
+template <unsigned Side>
+void BasicCandidateBoard<Side>::undo(std::size_t mark) noexcept
+{
+    assert(mark <= this->TrailSize_);
+    while (this->TrailSize_ > mark)
+    {
+        const auto& change = this->Trail_[--(this->TrailSize_)];
+        const auto cell = change.Cell;
+        if (change.Placement)
+        {
+            auto& value = (*this->Grid_)[cell / Side][cell % Side];
+            const auto digit = static_cast<unsigned>(value);
+            value = 0;
+            this->PlacedDigits_[row_unit(cell)].erase(digit);
+            this->PlacedDigits_[column_unit(cell)].erase(digit);
+            this->PlacedDigits_[subgrid_unit(cell)].erase(digit);
+        }
+
+        auto& candidates = this->Candidates_[cell / Side][cell % Side];
+        candidates |= change.Digits;
+        this->insert_positions(cell, change.Digits);
+        this->touch(cell);
+        this->set_single(cell, 1 == candidates.count());
+    }
+
+    this->Contradiction_ = false;
+}
+
+template class BasicCandidateBoard<4>;
+template class BasicCandidateBoard<9>;
+template class BasicCandidateBoard<16>;
+template class BasicCandidateBoard<25>;
@@ -0,0 +1,195 @@
+#pragma once
+
+#include "Deduction.h"
+#include "DigitMask.h"
+#include "GridLayout.h"
+#include "Matrix.h" // IWYU pragma: keep
+#include "SudokuGrid.h"
+
+#include <cstddef>
+#include <cstdint>
+
+/// @brief The candidates of every cell of a grid being solved.
+///
+/// The candidates are kept both per cell and per digit: for each digit and
+/// unit, the positions (see unit_cell()) where the digit still fits. Both
+/// views are updated together by place() and eliminate(), so that "where
+/// does 7 go in this subgrid" is a single mask.
+///
+/// Each unit (row, column or subgrid) carries a version, which changes
+/// whenever a candidate of one of its cells goes: techniques use it to
+/// only look again at the units which changed since they last found
+/// nothing there. Versions are drawn from a clock which is never rewound,
+/// and undo() gives new versions to the units it changes, so that a
+/// version is never reused for different candidates.
+///
+/// Changes can be recorded in a trail (see record()), to be taken back by
+/// undo(): a search can try a guess and backtrack without copying the
+/// board.
+template <unsigned Side>
+class BasicCandidateBoard final
+{
+public:
+    using grid_type = BasicSudokuGrid<Side>;
+    using candidate_mask = BasicDigitMask<Side>;
+    using candidate_grid = Matrix<candidate_mask, Side, Side>;
+    using deduction_type = BasicDeduction<Side>;
+    using layout_type = BasicGridLayout<Side>;
+
+    static constexpr unsigned CellCount = Side * Side;
+
+    /// @brief A change recorded in a trail: candidates removed from a
+    /// cell, or the ones it had when a digit was placed in it.
+    struct Change
+    {
+        std::uint16_t Cell;
+        bool Placement;
+        candidate_mask Digits;
+    };
+
+    /// @brief Number of changes a trail must have room for: each change
+    /// removes at least one candidate, so a cell can't change more than
+    /// Side times before undo() takes changes back.
+    static constexpr unsigned MaxChanges = CellCount * Side;
+
+    // Rows come first, then columns, then subgrids.
+    static constexpr unsigned UnitCount = 3 * Side;
+
+    static constexpr unsigned row_unit(unsigned cell) noexcept
+    {
+        return layout_type::row_unit(cell);
+    }
+
+    static constexpr unsigned column_unit(unsigned cell) noexcept
+    {
+        return layout_type::column_unit(cell);
+    }
+
+    static constexpr unsigned subgrid_unit(unsigned cell) noexcept
+    {
+        return layout_type::subgrid_unit(cell);
+    }
+
+    /// @brief The position of @p cell in its subgrid, in row-major order.
+    static constexpr unsigned subgrid_position(unsigned cell) noexcept
+    {
+        return layout_type::subgrid_position(cell);
+    }
+
+    /// @brief The @p i-th cell of @p unit, in row-major order.
+    static constexpr unsigned unit_cell(unsigned unit, unsigned i) noexcept
+    {
+        return layout_type::unit_cell(unit, i);
+    }
+
+    /// @brief A board without a grid yet, to be reset().
+    BasicCandidateBoard() noexcept = default;
+
+    /// @brief Compute the candidates of the empty cells of @p grid, which
+    /// is then filled in by place().
+    explicit BasicCandidateBoard(grid_type& grid);
+
+    /// @brief Start over on @p grid, as if the board were built for it.
+    /// The version clock keeps running.
+    void reset(grid_type& grid) noexcept;
+
+    candidate_mask candidates(unsigned cell) const noexcept
+    {
+        return this->Candidates_[cell / Side][cell % Side];
+    }
+
+    typename grid_type::value_type value(unsigned cell) const noexcept
+    {
+        return (*this->Grid_)[cell / Side][cell % Side];
+    }
+
+    const candidate_grid& candidateGrid() const noexcept;
+
+    /// @brief The positions of @p unit where @p digit fits, as a set of
+    /// indices in [1, Side]: index i + 1 stands for unit_cell(unit, i).
+    candidate_mask positions(unsigned digit, unsigned unit) const noexcept
+    {
+        return this->Positions_[digit - 1][unit];
+    }
+
+    /// @brief The digits placed in @p unit, givens included.
+    candidate_mask placedDigits(unsigned unit) const noexcept
+    {
+        return this->PlacedDigits_[unit];
+    }
+
+    std::uint32_t unitVersion(unsigned unit) const noexcept
+    {
+        return this->UnitVersions_[unit];
+    }
+
+    /// @brief A version of the whole board, which changes whenever a
+    /// candidate goes.
+    std::uint32_t version() const noexcept
+    {
+        return this->Clock_;
+    }
+
+    /// @brief Find a cell with a single candidate.
+    /// @return false if there's none.
+    bool find_single(unsigned& cell) const noexcept;
+
+    /// @brief Whether a given is repeated in a unit, or a cell was left
+    /// without candidates.
+    bool contradiction() const noexcept;
+
+    /// @brief Fill @p cell with @p digit, and remove it from its peers.
+    void place(unsigned cell, unsigned digit);
+
+    /// @return The number of candidates removed.
+    unsigned eliminate(unsigned cell, candidate_mask digits);
+
+    /// @brief Place the digit or remove the candidates of @p deduction.
+    void apply(const deduction_type& deduction);
+
+    /// @brief Record the changes made from now on in @p trail, which has
+    /// room for MaxChanges of them, or stop recording if null.
+    void record(Change* trail) noexcept;
+
+    bool recording() const noexcept
+    {
+        return nullptr != this->Trail_;
+    }
+
+    /// @brief Number of changes recorded, to be given to undo() later.
+    std::size_t changes() const noexcept
+    {
+        return this->TrailSize_;
+    }
+
+    /// @brief Take back the changes recorded after the first @p mark ones,
+    /// digits placed in the grid included.
+    /// @pre The board had no contradiction when changes() was @p mark.
+    void undo(std::size_t mark) noexcept;
+
+private:
+    void touch(unsigned cell) noexcept;
+    void set_single(unsigned cell, bool single) noexcept;
+    void erase_positions(unsigned cell, candidate_mask digits) noexcept;
+    void insert_positions(unsigned cell, candidate_mask digits) noexcept;
+    void push_change(unsigned cell, bool placement, candidate_mask digits) noexcept;
+
+    static constexpr unsigned SingleWordCount = (CellCount + 63) / 64;
+
+    grid_type* Grid_ = nullptr;
+    candidate_grid Candidates_;
+    candidate_mask Positions_[Side][UnitCount];
+    candidate_mask PlacedDigits_[UnitCount];
+    std::uint32_t UnitVersions_[UnitCount] = {};
+    std::uint32_t Clock_ = 0;
+
+    // One bit per cell left with a single candidate, so that naked singles
+    // needn't be looked for.
+    std::uint64_t SingleCells_[SingleWordCount] = {};
+    bool Contradiction_ = false;
+
+    Change* Trail_ = nullptr;
+    std::size_t TrailSize_ = 0;
+};
+
+using CandidateBoard = BasicCandidateBoard<9>;
@@ -0,0 +1,295 @@
+#include "Canonicalizer.h"
+
+#include <algorithm>
+
+namespace
+{
+
+constexpr unsigned Side = SudokuGridSide;
+constexpr unsigned BoxSide = SudokuSubgridSide;
+
+// Compares larger than any label.
+constexpr std::uint8_t EmptyLabel = Side + 1;
+
+const std::uint8_t Permutations[6][BoxSide] = {
+    { 0, 1, 2 },
+    { 0, 2, 1 },
+    { 1, 0, 2 },
+    { 1, 2, 0 },
+    { 2, 0, 1 },
+    { 2, 1, 0 }
+};
+
+std::uint64_t mix(std::uint64_t z) noexcept
+{
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+}
+
+void GridTransform::apply(const SudokuGrid& grid, SudokuGrid& result) const noexcept
+{
+    for (unsigned r = 0; r < Side; ++r)
+    {
+        for (unsigned c = 0; c < Side; ++c)
+        {
+            const auto value = this->Transposed ? grid[this->Columns[c]][this->Rows[r]] : grid[this->Rows[r]][this->Columns[c]];
+            result[r][c] = this->Digits[static_cast<unsigned>(value)];
+        }
+    }
+}
+
+void GridTransform::apply_inverse(const SudokuGrid& grid, SudokuGrid& result) const noexcept
+{
+    char digits[Side + 1] = {};
+    for (unsigned d = 0; d <= Side; ++d)
+    {
+        digits[static_cast<unsigned>(this->Digits[d])] = static_cast<char>(d);
+    }
+
+    for (unsigned r = 0; r < Side; ++r)
+    {
+        for (unsigned c = 0; c < Side; ++c)
+        {
+            auto& value = this->Transposed ? result[this->Columns[c]][this->Rows[r]] : result[this->Rows[r]][this->Columns[c]];
+            value = digits[static_cast<unsigned>(grid[r][c])];
+        }
+    }
+}
+
+GridTransform Canonicalizer::canonicalize(const SudokuGrid& grid, SudokuGrid& canonical)
+{
+    for (unsigned r = 0; r < Side; ++r)
+    {
+        for (unsigned c = 0; c < Side; ++c)
+        {
+            this->Lines_[0][r][c] = grid[r][c];
+            this->Lines_[1][c][r] = grid[r][c];
+        }
+    }
+
+    this->first_row();
+    for (unsigned row = 1; row < Side; ++row)
+    {
+        this->next_row(row);
+    }
+
+    // All the candidates left give the same form.
+    const auto& best = this->Candidates_.front();
+
+    GridTransform transform;
+    transform.Transposed = 0 != best.Transposed;
+    std::copy(best.Rows, best.Rows + Side, transform.Rows);
+    std::copy(best.Columns, best.Columns + Side, transform.Columns);
+
+    // The digits missing from the grid take the labels left, in order.
+    auto nextLabel = best.NextLabel;
+    for (unsigned d = 1; d <= Side; ++d)
+    {
+        transform.Digits[d] = static_cast<char>(0 != best.Labels[d] ? best.Labels[d] : nextLabel++);
+    }
+
+    transform.apply(grid, canonical);
+    return transform;
+}
+
+void Canonicalizer::first_row()
+{
+    // The first row puts its clues first, so it only depends on how many
+    // clues each stack has: the more the better, and the busiest stacks
+    // first. Find the best such row...
+    unsigned bestKey = 0;
+    for (unsigned t = 0; t < 2; ++t)
+    {
+        for (unsigned r = 0; r < Side; ++r)
+        {
+            unsigned counts[BoxSide] = {};
+            for (unsigned c = 0; c < Side; ++c)
+            {
+                counts[c / BoxSide] += !is_empty(this->Lines_[t][r][c]);
+            }
+
+            std::sort(counts, counts + BoxSide);
+            bestKey = std::max(bestKey, (counts[2] << 4) | (counts[1] << 2) | counts[0]);
+        }
+    }
+
+    // ... then every column order which makes it.
+    this->Candidates_.clear();
+    for (unsigned t = 0; t < 2; ++t)
+    {
+        for (unsigned r = 0; r < Side; ++r)
+        {
+            const auto* const line = this->Lines_[t][r];
+
+            unsigned counts[BoxSide] = {};
+            for (unsigned c = 0; c < Side; ++c)
+            {
+                counts[c / BoxSide] += !is_empty(line[c]);
+            }
+
+            unsigned sorted[BoxSide] = { counts[0], counts[1], counts[2] };
+            std::sort(sorted, sorted + BoxSide);
+            if (((sorted[2] << 4) | (sorted[1] << 2) | sorted[0]) != bestKey)
+                continue;
+
+            // The orders of each stack which put its clues first.
+            unsigned stackOrders[BoxSide][6] = {};
+            unsigned stackOrderCounts[BoxSide] = {};
+            for (unsigned s = 0; s < BoxSide; ++s)
+            {
+                for (unsigned p = 0; p < 6; ++p)
+                {
+                    const auto* const order = Permutations[p];
+                    const auto clue = [line, s, order](unsigned i) { return !is_empty(line[s * BoxSide + order[i]]); };
+                    if (clue(0) >= clue(1) && clue(1) >= clue(2))
+                    {
+                        stackOrders[s][stackOrderCounts[s]++] = p;
+                    }
+                }
+            }
+
+            for (const auto& stacks : Permutations)
+            {
+                if (counts[stacks[0]] < counts[stacks[1]] || counts[stacks[1]] < counts[stacks[2]])
+                    continue;
+
+                for (unsigned i0 = 0; i0 < stackOrderCounts[stacks[0]]; ++i0)
+                {
+                    for (unsigned i1 = 0; i1 < stackOrderCounts[stacks[1]]; ++i1)
+                    {
+                        for (unsigned i2 = 0; i2 < stackOrderCounts[stacks[2]]; ++i2)
+                        {
+                            const unsigned choices[BoxSide] = { i0, i1, i2 };
+
+                            Candidate candidate = {};
+                            candidate.Transposed = static_cast<std::uint8_t>(t);
+                            candidate.Rows[0] = static_cast<std::uint8_t>(r);
+                            candidate.UsedRows = static_cast<std::uint16_t>(1U << r);
+                            candidate.NextLabel = 1;
+                            for (unsigned s = 0; s < BoxSide; ++s)
+                            {
+                                const auto stack = stacks[s];
+                                const auto* const order = Permutations[stackOrders[stack][choices[s]]];
+                                for (unsigned i = 0; i < BoxSide; ++i)
+                                {
+                                    const auto column = static_cast<std::uint8_t>(stack * BoxSide + order[i]);
+                                    candidate.Columns[s * BoxSide + i] = column;
+
+                                    const auto value = static_cast<unsigned>(line[column]);
+                                    if (!is_empty(line[column]))
+                                    {
+                                        candidate.Labels[value] = candidate.NextLabel++;
+                                    }
+                                }
+                            }
+
+                            if (this->Candidates_.size() < MaxCandidates)
+                            {
+                                this->Candidates_.push_back(candidate);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+void Canonicalizer::next_row(unsigned row)
+{
+    std::uint8_t best[Side];
+    std::fill(best, best + Side, static_cast<std::uint8_t>(EmptyLabel + 1));
+
+    this->Next_.clear();
+    for (const auto& candidate : this->Candidates_)
+    {
+        // Within a band, the rows left in it. Otherwise, the rows of the
+        // bands left.
+        const auto previousBand = candidate.Rows[row - 1] / BoxSide;
+        for (unsigned r = 0; r < Side; ++r)
+        {
+            const auto band = r / BoxSide;
+            const auto bandRows = ((1U << BoxSide) - 1) << (band * BoxSide);
+            const auto allowed = 0 != row % BoxSide
+                ? band == previousBand && 0 == (candidate.UsedRows & (1U << r))
+                : 0 == (candidate.UsedRows & bandRows);
+            if (!allowed)
+                continue;
+
+            // -1: smaller than the best so far, 0: tied, 1: larger.
+            int order = 0;
+            std::uint8_t rowLabels[Side];
+            std::uint8_t labels[Side + 1];
+            std::copy(candidate.Labels, candidate.Labels + Side + 1, labels);
+            auto nextLabel = candidate.NextLabel;
+
+            const auto* const line = this->Lines_[candidate.Transposed][r];
+            for (unsigned c = 0; c < Side && order <= 0; ++c)
+            {
+                const auto value = static_cast<unsigned>(line[candidate.Columns[c]]);
+                auto label = EmptyLabel;
+                if (0 != value)
+                {
+                    if (0 == labels[value])
+                    {
+                        labels[value] = nextLabel++;
+                    }
+
+                    label = labels[value];
+                }
+
+                rowLabels[c] = label;
+                if (0 == order && label != best[c])
+                {
+                    order = label < best[c] ? -1 : 1;
+                }
+            }
+
+            if (order > 0)
+                continue;
+
+            if (order < 0)
+            {
+                std::copy(rowLabels, rowLabels + Side, best);
+                this->Next_.clear();
+            }
+
+            if (this->Next_.size() < MaxCandidates)
+            {
+                this->Next_.push_back(candidate);
+
+                auto& next = this->Next_.back();
+                next.Rows[row] = static_cast<std::uint8_t>(r);
+                next.UsedRows = static_cast<std::uint16_t>(next.UsedRows | (1U << r));
+                std::copy(labels, labels + Side + 1, next.Labels);
+                next.NextLabel = nextLabel;
+            }
+        }
+    }
+
+    this->Candidates_.swap(this->Next_);
+}
+
+std::uint64_t grid_hash(const SudokuGrid& grid) noexcept
+{
+    // Cells are packed 4 bits at a time, and each word is mixed in.
+    std::uint64_t hash = 0;
+    std::uint64_t word = 0;
+    unsigned bits = 0;
+    for (const auto value : grid)
+    {
+        word = (word << 4) | static_cast<std::uint64_t>(value);
+        bits += 4;
+        if (64 == bits)
+        {
+            hash = mix(hash ^ word) + 0x9E3779B97F4A7C15ULL;
+            word = 0;
+            bits = 0;
+        }
+    }
+
+    return mix(hash ^ word ^ bits);
+}
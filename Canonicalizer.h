@@ -0,0 +1,84 @@
+#pragma once
+
+#include "SudokuGrid.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// @brief A symmetry of 9x9 grids: an optional transposition, then a
+/// reordering of the rows and of the columns which keeps the bands and the
+/// stacks together, then a relabelling of the digits.
+///
+/// Any such transform keeps a grid valid, and maps the solutions of a
+/// puzzle to the solutions of the transformed puzzle.
+struct GridTransform
+{
+    bool Transposed = false;
+
+    /// Row r of the result is row Rows[r] of the (transposed) grid.
+    std::uint8_t Rows[SudokuGridSide] = { 0, 1, 2, 3, 4, 5, 6, 7, 8 };
+
+    /// Column c of the result is column Columns[c] of the (transposed) grid.
+    std::uint8_t Columns[SudokuGridSide] = { 0, 1, 2, 3, 4, 5, 6, 7, 8 };
+
+    /// Digit d becomes Digits[d]. Empty cells stay empty.
+    char Digits[SudokuGridSide + 1] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+
+    void apply(const SudokuGrid& grid, SudokuGrid& result) const noexcept;
+
+    /// @brief Undo apply(): apply_inverse(apply(g)) == g.
+    void apply_inverse(const SudokuGrid& grid, SudokuGrid& result) const noexcept;
+};
+
+/// @brief Maps 9x9 grids to a canonical form: the same one for all the
+/// grids one GridTransform away from each other.
+///
+/// The canonical form is the smallest transformed grid, compared row by row
+/// with digits relabelled in order of appearance and empty cells counting
+/// as larger than any digit. It is searched for one row at a time: only the
+/// transforms whose rows so far make the smallest prefix are carried on to
+/// the next row. The first row settles most of the column order, as the
+/// clues go first.
+///
+/// Grids with few clues leave many transforms tied. Past MaxCandidates of
+/// them, the extra ones are dropped: the form is still equivalent to the
+/// grid, but may no longer be the same for all equivalent grids.
+///
+/// The candidates are kept in buffers which are reused from one grid to
+/// the next.
+class Canonicalizer final
+{
+public:
+    static constexpr std::size_t MaxCandidates = 4096;
+
+    /// @brief Write the canonical form of @p grid into @p canonical.
+    /// @return The transform from @p grid to @p canonical.
+    GridTransform canonicalize(const SudokuGrid& grid, SudokuGrid& canonical);
+
+private:
+    struct Candidate
+    {
+        std::uint8_t Transposed;
+        std::uint8_t Rows[SudokuGridSide];
+        std::uint8_t Columns[SudokuGridSide];
+
+        /// The label of each digit so far, 0 if it wasn't met yet.
+        std::uint8_t Labels[SudokuGridSide + 1];
+        std::uint8_t NextLabel;
+        std::uint16_t UsedRows;
+    };
+
+    void first_row();
+    void next_row(unsigned row);
+
+    // The grid and its transposition.
+    char Lines_[2][SudokuGridSide][SudokuGridSide] = {};
+
+    std::vector<Candidate> Candidates_;
+    std::vector<Candidate> Next_;
+};
+
+/// @brief A 64-bit hash of @p grid. The hash of a canonical form stands for
+/// all the grids equivalent to it.
+std::uint64_t grid_hash(const SudokuGrid& grid) noexcept;
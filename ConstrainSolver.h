@@ -1,24 +1,69 @@
 #pragma once
 
-#include "fwd/SudokuGrid.h" // IWYU pragma: keep
-// IWYU pragma: no_include "SudokuGrid.h"
-
-#include "Matrix.h" // IWYU pragma: keep
+#include "CandidateBoard.h"
+#include "Deduction.h"
+#include "DigitMask.h"
 #include "Solver.h"
-#include "StaticVector.h"
+#include "Technique.h"
+#include "TechniquePipeline.h"
 
-class ConstrainSolver final : public Solver
+/// @brief Solves a grid by constraint propagation.
+///
+/// The solving techniques (see Technique) are strategy objects run by a
+/// BasicTechniquePipeline: after each deduction, the pipeline starts over
+/// from the cheapest technique, and each technique only looks again at the
+/// units whose candidates changed. Which techniques run is set at
+/// construction, and each one counts what it did in stats().
+///
+/// When the techniques get stuck, exec() guesses a digit for the cell with
+/// the fewest candidates and carries on, taking the guess back on a
+/// contradiction, so that it always ends with a definite answer.
+///
+/// All the state lives in fixed-size members, guesses included: the
+/// changes to the board are recorded in a trail, and taken back when a
+/// guess fails. Neither the constructor, reset() nor exec() allocate, and
+/// the stack doesn't grow with the number of nested guesses beyond a few
+/// locals per guess. A solver reset() for another grid keeps counting in
+/// stats().
+template <unsigned Side>
+class BasicConstrainSolver final : public BasicSolver<Side>
 {
 public:
-    explicit ConstrainSolver(SudokuGrid& grid);
+    using grid_type = typename BasicSolver<Side>::grid_type;
+
+    /// @brief A solver to be reset() for each grid.
+    explicit BasicConstrainSolver(TechniqueSet techniques = TechniqueSet::all()) noexcept;
+
+    explicit BasicConstrainSolver(grid_type& grid, TechniqueSet techniques = TechniqueSet::all());
 
+    void reset(grid_type& grid) override;
     bool exec() override;
+
+    /// @brief Number of deductions applied.
     unsigned iterations() const;
 
-    using candidate_collection = StaticVector<SudokuGrid::value_type, SudokuGrid::rows()>;
-    using candidate_grid = Matrix<candidate_collection, SudokuGrid::rows(), SudokuGrid::columns()>;
+    /// @brief Number of cells where exec() had to guess a digit.
+    unsigned branches() const;
+
+    TechniqueSet techniques() const noexcept;
+    const TechniqueStats& stats(Technique technique) const noexcept;
+
+    using candidate_mask = BasicDigitMask<Side>;
+    using candidate_grid = typename BasicCandidateBoard<Side>::candidate_grid;
 
 private:
-    candidate_grid CandidateGrid_;
+    /// @return false on a contradiction.
+    bool propagate();
+    bool search();
+
+    BasicCandidateBoard<Side> Board_;
+    BasicTechniquePipeline<Side> Pipeline_;
+    BasicDeduction<Side> Deduction_;
+
     unsigned Iterations_ = 0;
+    unsigned Branches_ = 0;
+
+    typename BasicCandidateBoard<Side>::Change Trail_[BasicCandidateBoard<Side>::MaxChanges];
 };
+
+using ConstrainSolver = BasicConstrainSolver<9>;
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "DigitMask.h"
+#include "StaticVector.h"
+#include "Technique.h"
+
+#include <cstdint>
+
+/// @brief One step of a technique: either a digit placed in a cell, or
+/// candidates removed from some cells.
+///
+/// Cells are numbered row * Side + column, units as in
+/// BasicCandidateBoard::unit_cell().
+template <unsigned Side>
+struct BasicDeduction
+{
+    using candidate_mask = BasicDigitMask<Side>;
+
+    struct Elimination
+    {
+        std::uint16_t Cell;
+        candidate_mask Digits;
+    };
+
+    Technique Kind = Technique::NakedSingle;
+
+    /// The board has no solution: a cell or a unit has no room left for a
+    /// digit. Nothing is placed nor eliminated.
+    bool Contradiction = false;
+
+    /// The unit the pattern was found in.
+    unsigned Unit = 0;
+
+    /// The cells and the digits which make the pattern. Singles place
+    /// their only digit in their only cell.
+    StaticVector<std::uint16_t, Side * Side> Cells;
+    candidate_mask Digits;
+
+    StaticVector<Elimination, Side * Side> Eliminations;
+
+    bool placement() const noexcept
+    {
+        return !this->Contradiction && (Technique::NakedSingle == this->Kind || Technique::HiddenSingle == this->Kind);
+    }
+
+    void clear() noexcept
+    {
+        this->Contradiction = false;
+        this->Unit = 0;
+        this->Cells.clear();
+        this->Digits.clear();
+        this->Eliminations.clear();
+    }
+};
+
+using Deduction = BasicDeduction<9>;
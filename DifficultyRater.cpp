@@ -0,0 +1,112 @@
+#include "DifficultyRater.h"
+
+#include "BatchSolver.h"
+#include "CandidateBoard.h"
+#include "ConstrainSolver.h"
+#include "Deduction.h"
+#include "TechniquePipeline.h"
+
+#include <algorithm>
+
+namespace
+{
+
+const double TechniqueScores[TechniqueCount] = {
+    1.0, // naked single
+    1.5, // hidden single
+    2.6, // pointing
+    2.8, // claiming
+    3.0, // naked pair
+    3.2, // x-wing
+    3.4, // hidden pair
+    3.6, // naked triple
+    3.8, // swordfish
+    4.0, // hidden triple
+    5.0, // naked quad
+    5.2, // jellyfish
+    5.4  // hidden quad
+};
+
+}
+
+double technique_score(Technique technique) noexcept
+{
+    return TechniqueScores[static_cast<unsigned>(technique)];
+}
+
+template <unsigned Side>
+BasicDifficultyRater<Side>::BasicDifficultyRater(TechniqueSet techniques) noexcept
+    : Techniques_(techniques)
+{ }
+
+template <unsigned Side>
+TechniqueSet BasicDifficultyRater<Side>::techniques() const noexcept
+{
+    return this->Techniques_;
+}
+
+template <unsigned Side>
+DifficultyRating BasicDifficultyRater<Side>::rate(const grid_type& grid) const
+{
+    DifficultyRating rating;
+
+    auto solved = grid;
+    BasicCandidateBoard<Side> board(solved);
+    BasicTechniquePipeline<Side> pipeline(this->Techniques_);
+    BasicDeduction<Side> deduction;
+    while (!board.contradiction() && pipeline.find(board, deduction))
+    {
+        board.apply(deduction);
+        if (deduction.Contradiction)
+            break;
+
+        ++rating.Steps;
+        rating.Hardest = std::max(rating.Hardest, deduction.Kind);
+    }
+
+    if (0 != rating.Steps)
+    {
+        rating.Score = technique_score(rating.Hardest);
+    }
+
+    // The techniques are sound: a contradiction means no solution at all.
+    if (board.contradiction())
+        return rating;
+
+    if (std::none_of(solved.begin(), solved.end(), is_empty))
+    {
+        rating.Solved = true;
+        return rating;
+    }
+
+    rating.NeedsSearch = true;
+    rating.Score = SearchScore;
+
+    BasicConstrainSolver<Side> solver(solved, this->Techniques_);
+    rating.Solved = solver.exec();
+    rating.Guesses = solver.branches();
+    return rating;
+}
+
+template <unsigned Side>
+std::vector<DifficultyRating> BasicDifficultyRater<Side>::rate_many(const grid_type* grids, std::size_t count, unsigned threadCount) const
+{
+    std::vector<DifficultyRating> ratings(count);
+
+    // Workers take a few grids at a time: most are rated in microseconds.
+    constexpr std::size_t chunkSize = 16;
+    parallel_for(count, chunkSize, threadCount, [this, &ratings, grids](std::size_t first, std::size_t last)
+    {
+        for (auto i = first; i < last; ++i)
+        {
+            ratings[i] = this->rate(grids[i]);
+        }
+    });
+
+    return ratings;
+}
+
+template class BasicDifficultyRater<4>;
+template class BasicDifficultyRater<9>;
+template class BasicDifficultyRater<16>;
+template class BasicDifficultyRater<25>;
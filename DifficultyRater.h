@@ -0,0 +1,71 @@
+#pragma once
+
+#include "SudokuGrid.h"
+#include "Technique.h"
+
+#include <cstddef>
+#include <vector>
+
+/// @brief How hard a grid is to solve by hand.
+struct DifficultyRating
+{
+    /// The grid has a solution. A grid with several is rated by the one
+    /// found first.
+    bool Solved = false;
+
+    /// The techniques got stuck before the grid was solved.
+    bool NeedsSearch = false;
+
+    /// The most expensive technique needed before any search.
+    Technique Hardest = Technique::NakedSingle;
+
+    /// Number of deductions applied before any search.
+    unsigned Steps = 0;
+
+    /// Number of cells where the search had to guess a digit.
+    unsigned Guesses = 0;
+
+    /// technique_score() of Hardest, or SearchScore when search was
+    /// needed. 0 for a grid without any deduction left to make.
+    double Score = 0;
+};
+
+/// The score of a grid the techniques can't finish.
+constexpr double SearchScore = 10.0;
+
+/// @brief The score of a grid whose hardest step is @p technique, close to
+/// the usual scale of hand solvers: from 1.0 for a naked single up to 5.4
+/// for a hidden quad, in the order of Technique.
+double technique_score(Technique technique) noexcept;
+
+/// @brief Rates grids by the techniques needed to solve them.
+///
+/// The grid is solved by a BasicTechniquePipeline, which takes the cheapest
+/// technique able to make progress at each step, and the hardest one
+/// applied tells the difficulty. Once the techniques are stuck, the grid
+/// is finished by guessing (see BasicConstrainSolver).
+///
+/// The rater has no mutable state, and can be shared between threads.
+template <unsigned Side>
+class BasicDifficultyRater final
+{
+public:
+    using grid_type = BasicSudokuGrid<Side>;
+
+    /// @param techniques The techniques a solver is expected to know.
+    explicit BasicDifficultyRater(TechniqueSet techniques = TechniqueSet::all()) noexcept;
+
+    TechniqueSet techniques() const noexcept;
+
+    DifficultyRating rate(const grid_type& grid) const;
+
+    /// @brief Rate @p count grids.
+    /// @param threadCount Number of threads (the calling thread included).
+    ///                    If 0, one per hardware thread is used.
+    std::vector<DifficultyRating> rate_many(const grid_type* grids, std::size_t count, unsigned threadCount = 0) const;
+
+private:
+    TechniqueSet Techniques_;
+};
+
+using DifficultyRater = BasicDifficultyRater<9>;
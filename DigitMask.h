@@ -0,0 +1,219 @@
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <type_traits>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace detail
+{
+
+inline unsigned popcount(std::uint32_t x) noexcept
+{
+#if defined(_MSC_VER)
+    return __popcnt(x);
+#else
+    return static_cast<unsigned>(__builtin_popcount(x));
+#endif
+}
+
+inline unsigned popcount(std::uint64_t x) noexcept
+{
+#if defined(_MSC_VER)
+    return static_cast<unsigned>(__popcnt64(x));
+#else
+    return static_cast<unsigned>(__builtin_popcountll(x));
+#endif
+}
+
+inline unsigned count_trailing_zeros(std::uint32_t x) noexcept
+{
+    assert(0 != x);
+#if defined(_MSC_VER)
+    unsigned long index = 0;
+    _BitScanForward(&index, x);
+    return index;
+#else
+    return static_cast<unsigned>(__builtin_ctz(x));
+#endif
+}
+
+inline unsigned count_trailing_zeros(std::uint64_t x) noexcept
+{
+    assert(0 != x);
+#if defined(_MSC_VER)
+    unsigned long index = 0;
+    _BitScanForward64(&index, x);
+    return index;
+#else
+    return static_cast<unsigned>(__builtin_ctzll(x));
+#endif
+}
+
+/// @brief The narrowest unsigned integer with at least @c Bits bits (up to 64).
+template <unsigned Bits>
+using mask_storage_t =
+    std::conditional_t<(Bits <= 16), std::uint16_t,
+    std::conditional_t<(Bits <= 32), std::uint32_t, std::uint64_t>>;
+
+/// @brief Promote 16-bit masks, which have no bit operation overloads.
+inline std::uint32_t widen(std::uint16_t x) noexcept
+{
+    return x;
+}
+
+inline std::uint32_t widen(std::uint32_t x) noexcept
+{
+    return x;
+}
+
+inline std::uint64_t widen(std::uint64_t x) noexcept
+{
+    return x;
+}
+
+}
+
+/// @brief A set of digits in [1, MaxDigit], stored as a bit mask.
+///
+/// Digit @c d is stored in bit @c d-1, so that set operations are single
+/// bitwise instructions. The mask is 16 bits wide for up to 16 digits,
+/// 32 bits for up to 32 digits and 64 bits otherwise.
+template <unsigned MaxDigit>
+class BasicDigitMask final
+{
+    static_assert(MaxDigit > 0 && MaxDigit <= 64, "Too many digits for a mask");
+
+public:
+    using storage_type = detail::mask_storage_t<MaxDigit>;
+
+    static constexpr unsigned maxDigit() noexcept
+    {
+        return MaxDigit;
+    }
+
+    constexpr BasicDigitMask() noexcept = default;
+
+    constexpr explicit BasicDigitMask(storage_type bits) noexcept
+        : Bits_(bits)
+    { }
+
+    /// @brief The set of all the digits in [1, maxDigit()].
+    static constexpr BasicDigitMask all() noexcept
+    {
+        return BasicDigitMask(static_cast<storage_type>(static_cast<storage_type>(~storage_type(0)) >> (8 * sizeof(storage_type) - MaxDigit)));
+    }
+
+    static constexpr BasicDigitMask single(unsigned digit) noexcept
+    {
+        return BasicDigitMask(static_cast<storage_type>(storage_type(1) << (digit - 1)));
+    }
+
+    constexpr storage_type bits() const noexcept
+    {
+        return this->Bits_;
+    }
+
+    constexpr bool empty() const noexcept
+    {
+        return 0 == this->Bits_;
+    }
+
+    unsigned count() const noexcept
+    {
+        return detail::popcount(detail::widen(this->Bits_));
+    }
+
+    constexpr bool contains(unsigned digit) const noexcept
+    {
+        return 0 != (this->Bits_ & single(digit).Bits_);
+    }
+
+    constexpr bool is_subset_of(BasicDigitMask other) const noexcept
+    {
+        return 0 == (this->Bits_ & ~other.Bits_);
+    }
+
+    /// @brief The smallest digit in the set. The set must not be empty.
+    unsigned lowest() const noexcept
+    {
+        return detail::count_trailing_zeros(detail::widen(this->Bits_)) + 1;
+    }
+
+    /// @brief Remove the smallest digit from the set and return it.
+    unsigned pop_lowest() noexcept
+    {
+        const auto digit = this->lowest();
+        this->Bits_ = static_cast<storage_type>(this->Bits_ & (this->Bits_ - 1));
+        return digit;
+    }
+
+    void insert(unsigned digit) noexcept
+    {
+        this->Bits_ = static_cast<storage_type>(this->Bits_ | single(digit).Bits_);
+    }
+
+    void erase(unsigned digit) noexcept
+    {
+        this->erase(single(digit));
+    }
+
+    /// @brief Remove all the digits of @p other from this set (and-not).
+    void erase(BasicDigitMask other) noexcept
+    {
+        this->Bits_ = static_cast<storage_type>(this->Bits_ & ~other.Bits_);
+    }
+
+    void clear() noexcept
+    {
+        this->Bits_ = 0;
+    }
+
+    BasicDigitMask& operator&=(BasicDigitMask other) noexcept
+    {
+        this->Bits_ = static_cast<storage_type>(this->Bits_ & other.Bits_);
+        return *this;
+    }
+
+    BasicDigitMask& operator|=(BasicDigitMask other) noexcept
+    {
+        this->Bits_ = static_cast<storage_type>(this->Bits_ | other.Bits_);
+        return *this;
+    }
+
+    friend constexpr BasicDigitMask operator&(BasicDigitMask lhs, BasicDigitMask rhs) noexcept
+    {
+        return BasicDigitMask(static_cast<storage_type>(lhs.Bits_ & rhs.Bits_));
+    }
+
+    friend constexpr BasicDigitMask operator|(BasicDigitMask lhs, BasicDigitMask rhs) noexcept
+    {
+        return BasicDigitMask(static_cast<storage_type>(lhs.Bits_ | rhs.Bits_));
+    }
+
+    friend constexpr bool operator==(BasicDigitMask lhs, BasicDigitMask rhs) noexcept
+    {
+        return lhs.Bits_ == rhs.Bits_;
+    }
+
+    friend constexpr bool operator!=(BasicDigitMask lhs, BasicDigitMask rhs) noexcept
+    {
+        return !(lhs == rhs);
+    }
+
+private:
+    storage_type Bits_ = 0;
+};
+
+/// @brief The digits of @p lhs which are not in @p rhs.
+template <unsigned MaxDigit>
+constexpr BasicDigitMask<MaxDigit> and_not(BasicDigitMask<MaxDigit> lhs, BasicDigitMask<MaxDigit> rhs) noexcept
+{
+    using storage_type = typename BasicDigitMask<MaxDigit>::storage_type;
+    return BasicDigitMask<MaxDigit>(static_cast<storage_type>(lhs.bits() & ~rhs.bits()));
+}
+
+using DigitMask = BasicDigitMask<9>;
@@ -0,0 +1,290 @@
+#include "DlxSolver.h"
+
+#include "SudokuGrid.h"
+
+#include <cassert>
+#include <limits>
+
+namespace
+{
+
+/// @brief The layout of the exact cover matrix for Side x Side grids.
+template <unsigned Side>
+struct DlxLayout
+{
+    static constexpr unsigned SubgridSide = BasicSudokuGrid<Side>::subgridSideLength();
+
+    static constexpr unsigned CellCount = Side * Side;
+    static constexpr unsigned PlacementCount = CellCount * Side;
+
+    // Cell, row-digit, column-digit and subgrid-digit constraints.
+    static constexpr unsigned ConstraintsPerPlacement = 4;
+    static constexpr unsigned ConstraintCount = ConstraintsPerPlacement * CellCount;
+
+    // The root node comes first, then the column headers, then the rows of
+    // the exact cover matrix (ConstraintsPerPlacement nodes each).
+    static constexpr unsigned Root = 0;
+    static constexpr unsigned FirstRowNode = 1 + ConstraintCount;
+    static constexpr unsigned NodeCount = FirstRowNode + ConstraintsPerPlacement * PlacementCount;
+
+    static constexpr unsigned placement_index(unsigned row, unsigned column, unsigned digit) noexcept
+    {
+        return (row * Side + column) * Side + (digit - 1);
+    }
+
+    static constexpr unsigned placement_first_node(unsigned placement) noexcept
+    {
+        return FirstRowNode + ConstraintsPerPlacement * placement;
+    }
+
+    static constexpr unsigned node_placement(unsigned node) noexcept
+    {
+        return (node - FirstRowNode) / ConstraintsPerPlacement;
+    }
+};
+
+}
+
+template <unsigned Side>
+BasicDlxSolver<Side>::BasicDlxSolver()
+    :
+      Nodes_(DlxLayout<Side>::NodeCount),
+      ColumnSizes_(DlxLayout<Side>::FirstRowNode, 0),
+      Solution_(DlxLayout<Side>::CellCount, 0)
+{
+    using layout = DlxLayout<Side>;
+    constexpr auto SubgridSide = layout::SubgridSide;
+    constexpr auto CellCount = layout::CellCount;
+    constexpr auto ConstraintsPerPlacement = layout::ConstraintsPerPlacement;
+    constexpr auto ConstraintCount = layout::ConstraintCount;
+    constexpr auto Root = layout::Root;
+    constexpr auto FirstRowNode = layout::FirstRowNode;
+    constexpr auto NodeCount = layout::NodeCount;
+
+    static_assert(NodeCount <= std::numeric_limits<index_type>::max(), "Node indices don't fit index_type");
+
+    // Circular list of the column headers, starting from the root.
+    for (index_type h = 0; h < FirstRowNode; ++h)
+    {
+        auto& header = this->Nodes_[h];
+        header.Left = static_cast<index_type>(0 == h ? ConstraintCount : h - 1);
+        header.Right = static_cast<index_type>(ConstraintCount == h ? Root : h + 1);
+        header.Up = h;
+        header.Down = h;
+        header.Column = h;
+    }
+
+    for (unsigned r = 0; r < Side; ++r)
+    {
+        for (unsigned c = 0; c < Side; ++c)
+        {
+            const auto subgrid = SubgridSide * (r / SubgridSide) + c / SubgridSide;
+            for (unsigned d = 1; d <= Side; ++d)
+            {
+                const unsigned columns[ConstraintsPerPlacement] = {
+                    1 + r * Side + c,
+                    1 + CellCount + r * Side + (d - 1),
+                    1 + 2 * CellCount + c * Side + (d - 1),
+                    1 + 3 * CellCount + subgrid * Side + (d - 1)
+                };
+
+                const auto first = layout::placement_first_node(layout::placement_index(r, c, d));
+                for (unsigned k = 0; k < ConstraintsPerPlacement; ++k)
+                {
+                    const auto n = static_cast<index_type>(first + k);
+                    const auto column = static_cast<index_type>(columns[k]);
+
+                    auto& node = this->Nodes_[n];
+                    node.Left = static_cast<index_type>(first + (k + ConstraintsPerPlacement - 1) % ConstraintsPerPlacement);
+                    node.Right = static_cast<index_type>(first + (k + 1) % ConstraintsPerPlacement);
+                    node.Column = column;
+
+                    // Append the node at the bottom of its column.
+                    auto& header = this->Nodes_[column];
+                    node.Up = header.Up;
+                    node.Down = column;
+                    this->Nodes_[header.Up].Down = n;
+                    header.Up = n;
+                    ++(this->ColumnSizes_[column]);
+                }
+            }
+        }
+    }
+}
+
+template <unsigned Side>
+BasicDlxSolver<Side>::BasicDlxSolver(grid_type& grid)
+    : BasicDlxSolver()
+{
+    this->reset(grid);
+}
+
+template <unsigned Side>
+unsigned long BasicDlxSolver<Side>::nodes() const noexcept
+{
+    return this->SearchNodes_;
+}
+
+template <unsigned Side>
+void BasicDlxSolver<Side>::cover(index_type column) noexcept
+{
+    auto& nodes = this->Nodes_;
+
+    nodes[nodes[column].Right].Left = nodes[column].Left;
+    nodes[nodes[column].Left].Right = nodes[column].Right;
+
+    for (auto i = nodes[column].Down; i != column; i = nodes[i].Down)
+    {
+        for (auto j = nodes[i].Right; j != i; j = nodes[j].Right)
+        {
+            nodes[nodes[j].Down].Up = nodes[j].Up;
+            nodes[nodes[j].Up].Down = nodes[j].Down;
+            --(this->ColumnSizes_[nodes[j].Column]);
+        }
+    }
+}
+
+template <unsigned Side>
+void BasicDlxSolver<Side>::uncover(index_type column) noexcept
+{
+    auto& nodes = this->Nodes_;
+
+    for (auto i = nodes[column].Up; i != column; i = nodes[i].Up)
+    {
+        for (auto j = nodes[i].Left; j != i; j = nodes[j].Left)
+        {
+            ++(this->ColumnSizes_[nodes[j].Column]);
+            nodes[nodes[j].Down].Up = j;
+            nodes[nodes[j].Up].Down = j;
+        }
+    }
+
+    nodes[nodes[column].Right].Left = column;
+    nodes[nodes[column].Left].Right = column;
+}
+
+template <unsigned Side>
+typename BasicDlxSolver<Side>::index_type BasicDlxSolver<Side>::choose_column() const noexcept
+{
+    constexpr auto Root = DlxLayout<Side>::Root;
+
+    auto best = this->Nodes_[Root].Right;
+    for (auto c = this->Nodes_[best].Right; c != Root; c = this->Nodes_[c].Right)
+    {
+        if (this->ColumnSizes_[best] <= 1)
+            break;
+
+        if (this->ColumnSizes_[c] < this->ColumnSizes_[best])
+        {
+            best = c;
+        }
+    }
+
+    return best;
+}
+
+template <unsigned Side>
+bool BasicDlxSolver<Side>::search(unsigned depth)
+{
+    using layout = DlxLayout<Side>;
+    constexpr auto Root = layout::Root;
+
+    ++(this->SearchNodes_);
+
+    if (Root == this->Nodes_[Root].Right)
+    {
+        for (unsigned i = 0; i < depth; ++i)
+        {
+            const auto placement = layout::node_placement(this->Solution_[i]);
+            const auto cell = placement / Side;
+            (*this->Grid_)[cell / Side][cell % Side] = static_cast<char>(placement % Side + 1);
+        }
+
+        return true;
+    }
+
+    const auto column = this->choose_column();
+    if (0 == this->ColumnSizes_[column])
+        return false;
+
+    bool found = false;
+    this->cover(column);
+    for (auto r = this->Nodes_[column].Down; r != column && !found; r = this->Nodes_[r].Down)
+    {
+        this->Solution_[depth] = r;
+        for (auto j = this->Nodes_[r].Right; j != r; j = this->Nodes_[j].Right)
+        {
+            this->cover(this->Nodes_[j].Column);
+        }
+
+        found = this->search(depth + 1);
+
+        for (auto j = this->Nodes_[r].Left; j != r; j = this->Nodes_[j].Left)
+        {
+            this->uncover(this->Nodes_[j].Column);
+        }
+    }
+    this->uncover(column);
+
+    return found;
+}
+
+template <unsigned Side>
+bool BasicDlxSolver<Side>::exec()
+{
+    using layout = DlxLayout<Side>;
+    constexpr auto ConstraintsPerPlacement = layout::ConstraintsPerPlacement;
+
+    this->SearchNodes_ = 0;
+
+    // Select the rows of the givens, unless two of them share a constraint.
+    const auto isCovered = [this](index_type column) { return this->Nodes_[this->Nodes_[column].Left].Right != column; };
+
+    bool consistent = true;
+    unsigned givens = 0;
+    for (unsigned r = 0; r < Side && consistent; ++r)
+    {
+        for (unsigned c = 0; c < Side && consistent; ++c)
+        {
+            const auto value = (*this->Grid_)[r][c];
+            if (is_empty(value))
+                continue;
+
+            const auto first = static_cast<index_type>(layout::placement_first_node(layout::placement_index(r, c, value)));
+            for (unsigned k = 0; k < ConstraintsPerPlacement; ++k)
+            {
+                consistent = consistent && !isCovered(this->Nodes_[first + k].Column);
+            }
+
+            if (consistent)
+            {
+                for (unsigned k = 0; k < ConstraintsPerPlacement; ++k)
+                {
+                    this->cover(this->Nodes_[first + k].Column);
+                }
+
+                this->Solution_[givens++] = first;
+            }
+        }
+    }
+
+    const auto solved = consistent && this->search(givens);
+
+    // Restore the node pool for the next call.
+    while (givens > 0)
+    {
+        const auto first = this->Solution_[--givens];
+        for (auto k = ConstraintsPerPlacement; k > 0; --k)
+        {
+            this->uncover(this->Nodes_[first + k - 1].Column);
+        }
+    }
+
+    this->InsertedDigits_ = solved ? this->NumberOfMissingDigits_ : 0;
+    return solved;
+}
+
+template class BasicDlxSolver<4>;
+template class BasicDlxSolver<9>;
+template class BasicDlxSolver<16>;
+template class BasicDlxSolver<25>;
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "Solver.h"
+
+#include <cstdint>
+#include <vector>
+
+/// @brief Solves a grid as an exact cover problem with Knuth's Dancing Links.
+///
+/// Every (row, column, digit) placement is a row of the exact cover matrix,
+/// which covers four constraints: the cell, the digit in the row, the digit
+/// in the column and the digit in the subgrid. The toroidal node pool is
+/// built once in the constructor; exec() covers the givens, searches and
+/// then uncovers everything, so that the pool is left as it was built and
+/// serves again for the next grid given to reset().
+template <unsigned Side>
+class BasicDlxSolver final : public BasicSolver<Side>
+{
+public:
+    using grid_type = typename BasicSolver<Side>::grid_type;
+
+    /// @brief A solver to be reset() for each grid.
+    BasicDlxSolver();
+
+    explicit BasicDlxSolver(grid_type& grid);
+
+    bool exec() override;
+
+    /// @brief Number of search nodes visited by the last exec().
+    unsigned long nodes() const noexcept;
+
+private:
+    using index_type = std::uint16_t;
+
+    struct Node
+    {
+        index_type Left;
+        index_type Right;
+        index_type Up;
+        index_type Down;
+        index_type Column;
+    };
+
+    void cover(index_type column) noexcept;
+    void uncover(index_type column) noexcept;
+
+    index_type choose_column() const noexcept;
+    bool search(unsigned depth);
+
+    std::vector<Node> Nodes_;
+    std::vector<index_type> ColumnSizes_;
+    std::vector<index_type> Solution_;
+    unsigned long SearchNodes_ = 0;
+};
+
+using DlxSolver = BasicDlxSolver<9>;
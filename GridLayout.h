@@ -0,0 +1,173 @@
+#pragma once
+
+#include "constexpr_functions.h"
+
+#include <cstdint>
+
+namespace detail
+{
+
+template <unsigned Side>
+struct GridTables
+{
+    static constexpr unsigned SubgridSide = Sqrt<Side>::value;
+    static constexpr unsigned CellCount = Side * Side;
+    static constexpr unsigned UnitCount = 3 * Side;
+    static constexpr unsigned PeerCount = 2 * (Side - 1) + (SubgridSide - 1) * (SubgridSide - 1);
+
+    static_assert(SubgridSide * SubgridSide == Side, "Grid side is not a square");
+
+    using cell_type = std::uint16_t;
+    using index_type = std::uint8_t;
+
+    cell_type UnitCells[UnitCount][Side];
+    cell_type Peers[CellCount][PeerCount];
+
+    index_type Rows[CellCount];
+    index_type Columns[CellCount];
+    index_type Subgrids[CellCount];
+    index_type SubgridPositions[CellCount];
+};
+
+template <unsigned Side>
+constexpr GridTables<Side> make_grid_tables() noexcept
+{
+    using tables_type = GridTables<Side>;
+    using cell_type = typename tables_type::cell_type;
+    using index_type = typename tables_type::index_type;
+    constexpr auto SubgridSide = tables_type::SubgridSide;
+    constexpr auto CellCount = tables_type::CellCount;
+
+    tables_type tables {};
+    for (unsigned cell = 0; cell < CellCount; ++cell)
+    {
+        const auto row = cell / Side;
+        const auto column = cell % Side;
+        const auto subgrid = SubgridSide * (row / SubgridSide) + column / SubgridSide;
+        const auto position = SubgridSide * (row % SubgridSide) + column % SubgridSide;
+
+        tables.Rows[cell] = static_cast<index_type>(row);
+        tables.Columns[cell] = static_cast<index_type>(column);
+        tables.Subgrids[cell] = static_cast<index_type>(subgrid);
+        tables.SubgridPositions[cell] = static_cast<index_type>(position);
+
+        tables.UnitCells[row][column] = static_cast<cell_type>(cell);
+        tables.UnitCells[Side + column][row] = static_cast<cell_type>(cell);
+        tables.UnitCells[2 * Side + subgrid][position] = static_cast<cell_type>(cell);
+    }
+
+    for (unsigned cell = 0; cell < CellCount; ++cell)
+    {
+        const auto row = cell / Side;
+        const auto column = cell % Side;
+        const auto firstRow = SubgridSide * (row / SubgridSide);
+        const auto firstColumn = SubgridSide * (column / SubgridSide);
+
+        auto* peers = tables.Peers[cell];
+        unsigned count = 0;
+        for (unsigned i = 0; i < Side; ++i)
+        {
+            if (i != column)
+            {
+                peers[count++] = static_cast<cell_type>(row * Side + i);
+            }
+        }
+
+        for (unsigned i = 0; i < Side; ++i)
+        {
+            if (i != row)
+            {
+                peers[count++] = static_cast<cell_type>(i * Side + column);
+            }
+        }
+
+        // The subgrid cells off the row and the column of the cell.
+        for (unsigned r = firstRow; r < firstRow + SubgridSide; ++r)
+        {
+            for (unsigned c = firstColumn; c < firstColumn + SubgridSide; ++c)
+            {
+                if (r != row && c != column)
+                {
+                    peers[count++] = static_cast<cell_type>(r * Side + c);
+                }
+            }
+        }
+    }
+
+    return tables;
+}
+
+}
+
+/// @brief The units and the peers of the cells of a Side x Side grid, as
+/// tables computed at compile time.
+///
+/// Cells are numbered row * Side + column. Rows are the units [0, Side),
+/// columns the units [Side, 2 * Side) and subgrids the units
+/// [2 * Side, 3 * Side), each listing its cells in row-major order. The
+/// peers of a cell are the other cells of its three units: the ones of its
+/// row, then of its column, then the rest of its subgrid.
+///
+/// Loops over a unit or over the peers of a cell read a flat array of cell
+/// indices instead of dividing by the side and the subgrid side.
+template <unsigned Side>
+struct BasicGridLayout final
+{
+    using tables_type = detail::GridTables<Side>;
+    using cell_type = typename tables_type::cell_type;
+
+    static constexpr unsigned SubgridSide = tables_type::SubgridSide;
+    static constexpr unsigned CellCount = tables_type::CellCount;
+    static constexpr unsigned UnitCount = tables_type::UnitCount;
+    static constexpr unsigned PeerCount = tables_type::PeerCount;
+
+    static constexpr unsigned row_unit(unsigned cell) noexcept
+    {
+        return Table.Rows[cell];
+    }
+
+    static constexpr unsigned column_unit(unsigned cell) noexcept
+    {
+        return Side + Table.Columns[cell];
+    }
+
+    static constexpr unsigned subgrid_unit(unsigned cell) noexcept
+    {
+        return 2 * Side + subgrid(cell);
+    }
+
+    /// @brief The subgrid of @p cell, in [0, Side), in row-major order.
+    static constexpr unsigned subgrid(unsigned cell) noexcept
+    {
+        return Table.Subgrids[cell];
+    }
+
+    /// @brief The position of @p cell in its subgrid, in row-major order.
+    static constexpr unsigned subgrid_position(unsigned cell) noexcept
+    {
+        return Table.SubgridPositions[cell];
+    }
+
+    /// @brief The @p i-th cell of @p unit.
+    static constexpr unsigned unit_cell(unsigned unit, unsigned i) noexcept
+    {
+        return Table.UnitCells[unit][i];
+    }
+
+    static constexpr const cell_type* unit_cells(unsigned unit) noexcept
+    {
+        return Table.UnitCells[unit];
+    }
+
+    static constexpr const cell_type* peers(unsigned cell) noexcept
+    {
+        return Table.Peers[cell];
+    }
+
+    static constexpr tables_type Table = detail::make_grid_tables<Side>();
+};
+
+template <unsigned Side>
+constexpr typename BasicGridLayout<Side>::tables_type BasicGridLayout<Side>::Table;
+
+using GridLayout = BasicGridLayout<9>;
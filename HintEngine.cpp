@@ -0,0 +1,99 @@
+#include "HintEngine.h"
+
+template <unsigned Side>
+BasicHintEngine<Side>::BasicHintEngine(TechniqueSet techniques) noexcept
+    : Pipeline_(techniques)
+{ }
+
+template <unsigned Side>
+TechniqueSet BasicHintEngine<Side>::techniques() const noexcept
+{
+    return this->Pipeline_.techniques();
+}
+
+template <unsigned Side>
+const typename BasicHintEngine<Side>::grid_type& BasicHintEngine<Side>::grid() const noexcept
+{
+    return this->Grid_;
+}
+
+template <unsigned Side>
+const typename BasicHintEngine<Side>::board_type& BasicHintEngine<Side>::board() const noexcept
+{
+    return this->Board_;
+}
+
+template <unsigned Side>
+void BasicHintEngine<Side>::update(const grid_type& grid)
+{
+    if (!this->Started_)
+    {
+        this->restart(grid);
+        return;
+    }
+
+    // The new digits go on the board one at a time, so that each one must
+    // still be a candidate once the previous ones are placed.
+    const auto* values = &grid[0][0];
+    const auto* current = &this->Grid_[0][0];
+    for (unsigned cell = 0; cell < Side * Side; ++cell)
+    {
+        const auto value = values[cell];
+        if (value == current[cell])
+            continue;
+
+        if (!is_empty(current[cell]) || is_empty(value) ||
+            !this->Board_.candidates(cell).contains(static_cast<unsigned>(value)))
+        {
+            this->restart(grid);
+            return;
+        }
+
+        this->Board_.place(cell, static_cast<unsigned>(value));
+        this->HasHint_ = false;
+    }
+}
+
+template <unsigned Side>
+bool BasicHintEngine<Side>::next(deduction_type& hint)
+{
+    if (!this->HasHint_)
+    {
+        if (!this->Started_ || this->Board_.contradiction() || !this->Pipeline_.find(this->Board_, this->Hint_))
+            return false;
+
+        this->HasHint_ = true;
+    }
+
+    hint = this->Hint_;
+    return true;
+}
+
+template <unsigned Side>
+bool BasicHintEngine<Side>::next(const grid_type& grid, deduction_type& hint)
+{
+    this->update(grid);
+    return this->next(hint);
+}
+
+template <unsigned Side>
+void BasicHintEngine<Side>::apply(const deduction_type& hint)
+{
+    this->Board_.apply(hint);
+    this->HasHint_ = false;
+}
+
+template <unsigned Side>
+void BasicHintEngine<Side>::restart(const grid_type& grid)
+{
+    this->Grid_ = grid;
+    this->Board_.reset(this->Grid_);
+    this->Pipeline_.reset();
+    this->HasHint_ = false;
+    this->Started_ = true;
+}
+
+template class BasicHintEngine<4>;
+template class BasicHintEngine<9>;
+template class BasicHintEngine<16>;
+template class BasicHintEngine<25>;
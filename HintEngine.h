@@ -0,0 +1,81 @@
+#pragma once
+
+#include "CandidateBoard.h"
+#include "Deduction.h"
+#include "SudokuGrid.h"
+#include "Technique.h"
+#include "TechniquePipeline.h"
+
+/// @brief Finds the next logical step of a grid being solved by hand,
+/// without solving the rest of it.
+///
+/// A hint is the deduction of the cheapest technique able to make progress
+/// (see BasicTechniquePipeline): the technique, the cells and digits of its
+/// pattern, and the digit it places or the candidates it removes.
+///
+/// The engine follows one grid. The candidate board and the techniques'
+/// record of what they already looked at are kept from one call to the
+/// next: after a hint is applied, or a few digits are placed, only the
+/// units which changed are looked at again. Any other change to the grid
+/// (a digit erased or overwritten, or one which isn't a candidate) starts
+/// over from the new grid.
+///
+/// The engine can't be copied nor moved, as its board refers to its grid.
+template <unsigned Side>
+class BasicHintEngine final
+{
+public:
+    using grid_type = BasicSudokuGrid<Side>;
+    using board_type = BasicCandidateBoard<Side>;
+    using deduction_type = BasicDeduction<Side>;
+
+    explicit BasicHintEngine(TechniqueSet techniques = TechniqueSet::all()) noexcept;
+
+    BasicHintEngine(const BasicHintEngine&) = delete;
+    BasicHintEngine(BasicHintEngine&&) = delete;
+
+    BasicHintEngine& operator=(const BasicHintEngine&) = delete;
+    BasicHintEngine& operator=(BasicHintEngine&&) = delete;
+
+    TechniqueSet techniques() const noexcept;
+
+    /// @brief The grid followed, with the digits of the applied hints.
+    const grid_type& grid() const noexcept;
+
+    /// @brief The candidates left by the applied hints.
+    const board_type& board() const noexcept;
+
+    /// @brief Follow @p grid from now on.
+    void update(const grid_type& grid);
+
+    /// @brief Look for the cheapest deduction on the grid followed.
+    ///
+    /// A contradiction found by a technique is a hint, too, with
+    /// Contradiction set. Asking again before anything changes gives the
+    /// same hint, without looking for it again.
+    /// @return false if there's none: no grid was given yet, or the grid
+    /// is full, has conflicting digits, or is beyond the techniques.
+    bool next(deduction_type& hint);
+
+    /// @brief update(grid), then next(hint).
+    bool next(const grid_type& grid, deduction_type& hint);
+
+    /// @brief Take a hint returned by next() as made: its digit is placed
+    /// or its candidates are removed.
+    void apply(const deduction_type& hint);
+
+private:
+    void restart(const grid_type& grid);
+
+    grid_type Grid_;
+    board_type Board_;
+    BasicTechniquePipeline<Side> Pipeline_;
+
+    // The answer of next() until the board changes.
+    deduction_type Hint_;
+    bool HasHint_ = false;
+
+    bool Started_ = false;
+};
+
+using HintEngine = BasicHintEngine<9>;
@@ -0,0 +1,240 @@
+#include "IncrementalBoard.h"
+
+#include "GridLayout.h"
+
+#include <initializer_list>
+
+namespace
+{
+
+template <unsigned Side>
+using unit_layout = BasicGridLayout<Side>;
+
+}
+
+template <unsigned Side>
+BasicIncrementalBoard<Side>::BasicIncrementalBoard(const grid_type& puzzle)
+{
+    // Room for a player to fill every cell once before any reallocation.
+    this->Moves_.reserve(CellCount);
+    this->reset(puzzle);
+}
+
+template <unsigned Side>
+void BasicIncrementalBoard<Side>::reset(const grid_type& puzzle)
+{
+    this->Grid_ = puzzle;
+    this->Moves_.clear();
+
+    for (auto& counts : this->DigitCounts_)
+    {
+        for (auto& count : counts)
+        {
+            count = 0;
+        }
+    }
+
+    for (auto& digits : this->PlacedDigits_)
+    {
+        digits.clear();
+    }
+
+    this->Conflicts_ = 0;
+    this->FilledCells_ = 0;
+
+    const auto* values = &this->Grid_[0][0];
+    for (unsigned cell = 0; cell < CellCount; ++cell)
+    {
+        this->Givens_[cell] = !is_empty(values[cell]);
+        if (this->Givens_[cell])
+        {
+            this->add(cell, values[cell]);
+            ++(this->FilledCells_);
+        }
+    }
+
+    this->BlockedCells_ = 0;
+    for (unsigned cell = 0; cell < CellCount; ++cell)
+    {
+        this->Blocked_[cell] = false;
+        this->refresh(cell);
+    }
+}
+
+template <unsigned Side>
+const typename BasicIncrementalBoard<Side>::grid_type& BasicIncrementalBoard<Side>::grid() const noexcept
+{
+    return this->Grid_;
+}
+
+template <unsigned Side>
+bool BasicIncrementalBoard<Side>::isConflicting(unsigned row, unsigned column) const noexcept
+{
+    const auto value = this->Grid_[row][column];
+    if (is_empty(value))
+        return false;
+
+    const auto cell = row * Side + column;
+    const auto digit = static_cast<unsigned>(value) - 1;
+    return this->DigitCounts_[unit_layout<Side>::row_unit(cell)][digit] > 1 ||
+           this->DigitCounts_[unit_layout<Side>::column_unit(cell)][digit] > 1 ||
+           this->DigitCounts_[unit_layout<Side>::subgrid_unit(cell)][digit] > 1;
+}
+
+template <unsigned Side>
+unsigned BasicIncrementalBoard<Side>::conflicts() const noexcept
+{
+    return this->Conflicts_;
+}
+
+template <unsigned Side>
+unsigned BasicIncrementalBoard<Side>::blockedCells() const noexcept
+{
+    return this->BlockedCells_;
+}
+
+template <unsigned Side>
+unsigned BasicIncrementalBoard<Side>::filledCells() const noexcept
+{
+    return this->FilledCells_;
+}
+
+template <unsigned Side>
+bool BasicIncrementalBoard<Side>::solved() const noexcept
+{
+    return CellCount == this->FilledCells_ && 0 == this->Conflicts_;
+}
+
+template <unsigned Side>
+bool BasicIncrementalBoard<Side>::place(unsigned row, unsigned column, unsigned digit)
+{
+    const auto cell = row * Side + column;
+    const auto value = static_cast<char>(digit);
+    if (0 == digit || digit > Side || this->Givens_[cell] || value == this->Grid_[row][column])
+        return false;
+
+    this->Moves_.push_back({ static_cast<std::uint16_t>(cell), this->Grid_[row][column] });
+    this->set(cell, value);
+    return true;
+}
+
+template <unsigned Side>
+bool BasicIncrementalBoard<Side>::erase(unsigned row, unsigned column)
+{
+    const auto cell = row * Side + column;
+    if (this->Givens_[cell] || is_empty(this->Grid_[row][column]))
+        return false;
+
+    this->Moves_.push_back({ static_cast<std::uint16_t>(cell), this->Grid_[row][column] });
+    this->set(cell, 0);
+    return true;
+}
+
+template <unsigned Side>
+bool BasicIncrementalBoard<Side>::undo() noexcept
+{
+    if (this->Moves_.empty())
+        return false;
+
+    const auto move = this->Moves_.back();
+    this->Moves_.pop_back();
+    this->set(move.Cell, move.Previous);
+    return true;
+}
+
+template <unsigned Side>
+std::size_t BasicIncrementalBoard<Side>::moves() const noexcept
+{
+    return this->Moves_.size();
+}
+
+template <unsigned Side>
+void BasicIncrementalBoard<Side>::set(unsigned cell, char value) noexcept
+{
+    auto& current = this->Grid_[cell / Side][cell % Side];
+    if (!is_empty(current))
+    {
+        this->remove(cell, current);
+        --(this->FilledCells_);
+    }
+
+    if (!is_empty(value))
+    {
+        this->add(cell, value);
+        ++(this->FilledCells_);
+    }
+
+    current = value;
+
+    // The cell itself, and its peers.
+    this->refresh(cell);
+
+    const auto* peers = unit_layout<Side>::peers(cell);
+    for (unsigned i = 0; i < unit_layout<Side>::PeerCount; ++i)
+    {
+        this->refresh(peers[i]);
+    }
+}
+
+template <unsigned Side>
+void BasicIncrementalBoard<Side>::add(unsigned cell, char value) noexcept
+{
+    const auto digit = static_cast<unsigned>(value);
+    for (const auto unit : { unit_layout<Side>::row_unit(cell), unit_layout<Side>::column_unit(cell), unit_layout<Side>::subgrid_unit(cell) })
+    {
+        auto& count = this->DigitCounts_[unit][digit - 1];
+        if (0 != count)
+        {
+            ++(this->Conflicts_);
+        }
+
+        ++count;
+        this->PlacedDigits_[unit].insert(digit);
+    }
+}
+
+template <unsigned Side>
+void BasicIncrementalBoard<Side>::remove(unsigned cell, char value) noexcept
+{
+    const auto digit = static_cast<unsigned>(value);
+    for (const auto unit : { unit_layout<Side>::row_unit(cell), unit_layout<Side>::column_unit(cell), unit_layout<Side>::subgrid_unit(cell) })
+    {
+        auto& count = this->DigitCounts_[unit][digit - 1];
+        --count;
+        if (0 != count)
+        {
+            --(this->Conflicts_);
+        }
+        else
+        {
+            this->PlacedDigits_[unit].erase(digit);
+        }
+    }
+}
+
+template <unsigned Side>
+void BasicIncrementalBoard<Side>::refresh(unsigned cell) noexcept
+{
+    auto& candidates = this->Candidates_[cell];
+    candidates.clear();
+    if (is_empty(this->Grid_[cell / Side][cell % Side]))
+    {
+        const auto forbiddenDigits =
+            this->PlacedDigits_[unit_layout<Side>::row_unit(cell)] |
+            this->PlacedDigits_[unit_layout<Side>::column_unit(cell)] |
+            this->PlacedDigits_[unit_layout<Side>::subgrid_unit(cell)];
+        candidates = and_not(candidate_mask::all(), forbiddenDigits);
+    }
+
+    const auto blocked = is_empty(this->Grid_[cell / Side][cell % Side]) && candidates.empty();
+    if (blocked != this->Blocked_[cell])
+    {
+        this->Blocked_[cell] = blocked;
+        this->BlockedCells_ = blocked ? this->BlockedCells_ + 1 : this->BlockedCells_ - 1;
+    }
+}
+
+template class BasicIncrementalBoard<4>;
+template class BasicIncrementalBoard<9>;
+template class BasicIncrementalBoard<16>;
+template class BasicIncrementalBoard<25>;
@@ -0,0 +1,121 @@
+#pragma once
+
+#include "DigitMask.h"
+#include "SudokuGrid.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// @brief A grid being filled in by a player, one move at a time.
+///
+/// Unlike BasicCandidateBoard, which only ever places digits that fit, the
+/// player may place any digit, erase it again and undo moves: each unit
+/// counts how many times it holds each digit, so that a move only updates
+/// its three units, and the candidates of the cell and of its peers.
+/// Queries then read what is kept: candidates, conflicts and counts are
+/// answered in constant time, without looking at the rest of the grid.
+///
+/// The givens of the puzzle can't be changed. A board has no shared state:
+/// boards of different players can be used from different threads without
+/// locking.
+template <unsigned Side>
+class BasicIncrementalBoard final
+{
+public:
+    using grid_type = BasicSudokuGrid<Side>;
+    using candidate_mask = BasicDigitMask<Side>;
+
+    static constexpr unsigned CellCount = Side * Side;
+
+    explicit BasicIncrementalBoard(const grid_type& puzzle);
+
+    /// @brief Start over from @p puzzle, forgetting every move.
+    void reset(const grid_type& puzzle);
+
+    const grid_type& grid() const noexcept;
+
+    char value(unsigned row, unsigned column) const noexcept
+    {
+        return this->Grid_[row][column];
+    }
+
+    bool isGiven(unsigned row, unsigned column) const noexcept
+    {
+        return this->Givens_[row * Side + column];
+    }
+
+    /// @brief The digits which fit in an empty cell, given the digits in
+    /// its units. Filled cells have none.
+    candidate_mask candidates(unsigned row, unsigned column) const noexcept
+    {
+        return this->Candidates_[row * Side + column];
+    }
+
+    /// @brief Whether the digit of a cell is repeated in one of its units.
+    bool isConflicting(unsigned row, unsigned column) const noexcept;
+
+    /// @brief Number of repeated digits: a digit three times in a unit
+    /// counts twice.
+    unsigned conflicts() const noexcept;
+
+    /// @brief Number of empty cells without any candidate.
+    unsigned blockedCells() const noexcept;
+
+    unsigned filledCells() const noexcept;
+
+    /// @brief Whether every cell is filled, without conflicts.
+    bool solved() const noexcept;
+
+    /// @brief Put @p digit, in [1, Side], in a cell which isn't a given,
+    /// replacing its digit if any.
+    /// @return false if nothing was done.
+    bool place(unsigned row, unsigned column, unsigned digit);
+
+    /// @brief Empty a cell which isn't a given.
+    /// @return false if the cell was already empty, or is a given.
+    bool erase(unsigned row, unsigned column);
+
+    /// @brief Take the last place() or erase() back.
+    /// @return false if there's no move left to undo.
+    bool undo() noexcept;
+
+    /// @brief Number of moves undo() can take back.
+    std::size_t moves() const noexcept;
+
+private:
+    struct Move
+    {
+        std::uint16_t Cell;
+        char Previous;
+    };
+
+    static constexpr unsigned UnitCount = 3 * Side;
+
+    /// @brief Set the value of @p cell and update its units, its
+    /// candidates and the ones of its peers.
+    void set(unsigned cell, char value) noexcept;
+
+    void add(unsigned cell, char value) noexcept;
+    void remove(unsigned cell, char value) noexcept;
+    void refresh(unsigned cell) noexcept;
+
+    grid_type Grid_;
+    bool Givens_[CellCount] = {};
+
+    // How many times each unit holds each digit; the digits held at least
+    // once as a mask.
+    std::uint8_t DigitCounts_[UnitCount][Side] = {};
+    candidate_mask PlacedDigits_[UnitCount];
+
+    candidate_mask Candidates_[CellCount];
+    bool Blocked_[CellCount] = {};
+
+    unsigned Conflicts_ = 0;
+    unsigned BlockedCells_ = 0;
+    unsigned FilledCells_ = 0;
+
+    std::vector<Move> Moves_;
+};
+
+using IncrementalBoard = BasicIncrementalBoard<9>;
@@ -0,0 +1,107 @@
+// Built with AVX2 code generation where the compiler supports it: nothing
+// in here may be called before LockstepSolver checked the CPU.
+
+#include "LockstepKernel.h"
+
+#if defined(__AVX2__)
+
+#include <immintrin.h>
+
+namespace
+{
+
+struct Avx2Lanes
+{
+    using vector = __m256i;
+
+    static constexpr unsigned Width = 16;
+
+    static vector load(const std::uint16_t* p) noexcept
+    {
+        return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+    }
+
+    static void store(std::uint16_t* p, vector v) noexcept
+    {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v);
+    }
+
+    static vector zero() noexcept
+    {
+        return _mm256_setzero_si256();
+    }
+
+    static vector broadcast(std::uint16_t x) noexcept
+    {
+        return _mm256_set1_epi16(static_cast<short>(x));
+    }
+
+    static vector bit_and(vector a, vector b) noexcept
+    {
+        return _mm256_and_si256(a, b);
+    }
+
+    static vector bit_or(vector a, vector b) noexcept
+    {
+        return _mm256_or_si256(a, b);
+    }
+
+    static vector bit_xor(vector a, vector b) noexcept
+    {
+        return _mm256_xor_si256(a, b);
+    }
+
+    /// a & ~b
+    static vector and_not(vector a, vector b) noexcept
+    {
+        return _mm256_andnot_si256(b, a);
+    }
+
+    /// All ones in the lanes of @p v which are zero.
+    static vector is_zero(vector v) noexcept
+    {
+        return _mm256_cmpeq_epi16(v, zero());
+    }
+
+    /// The lanes of @p v with a single bit set, the others cleared.
+    static vector singles(vector v) noexcept
+    {
+        const auto lowestCleared = _mm256_and_si256(v, _mm256_sub_epi16(v, broadcast(1)));
+        return _mm256_and_si256(v, is_zero(lowestCleared));
+    }
+
+    /// @p a where @p mask is set, @p b elsewhere.
+    static vector select(vector mask, vector a, vector b) noexcept
+    {
+        return _mm256_blendv_epi8(b, a, mask);
+    }
+
+    static bool any(vector v) noexcept
+    {
+        return 0 == _mm256_testz_si256(v, v);
+    }
+};
+
+}
+
+bool lockstep_avx2_built() noexcept
+{
+    return true;
+}
+
+void lockstep_propagate_avx2(std::uint16_t* cells, unsigned stride, const lockstep_units& units, std::uint16_t* contradictions)
+{
+    lockstep_propagate<Avx2Lanes>(cells, stride, units, contradictions);
+}
+
+#else
+
+bool lockstep_avx2_built() noexcept
+{
+    return false;
+}
+
+void lockstep_propagate_avx2(std::uint16_t*, unsigned, const lockstep_units&, std::uint16_t*)
+{ }
+
+#endif
@@ -0,0 +1,95 @@
+#pragma once
+
+// The singles propagation run by LockstepSolver on a group of 9x9 grids,
+// written once against a "lanes" type which provides the vector operations
+// of an instruction set.
+//
+// Each instruction set gets its own translation unit, compiled for it, and
+// its lanes type lives in an anonymous namespace there: the instantiations
+// of the kernel then stay in that translation unit, and code compiled for
+// AVX2 can't end up being called on a CPU without it. For the same reason,
+// this header includes nothing but <cstdint>.
+
+#include <cstdint>
+
+static constexpr unsigned LockstepCellCount = 81;
+static constexpr unsigned LockstepUnitCount = 27;
+static constexpr unsigned LockstepUnitSize = 9;
+static constexpr std::uint16_t LockstepAllDigits = 0x1FF;
+
+/// @brief The cells of each row, column and subgrid, laid out as
+/// GridLayout::Table.UnitCells.
+using lockstep_units = std::uint16_t[LockstepUnitCount][LockstepUnitSize];
+
+/// @brief Propagate naked and hidden singles on Lanes::Width grids at once,
+/// until none of them changes.
+///
+/// @param cells The candidates of the grids, one lane per grid: those of
+///              cell i are at cells[i * stride], cells[i * stride + 1]...
+/// @param contradictions Set to non-zero for the grids found to have no
+///                       solution.
+template <typename Lanes>
+void lockstep_propagate(std::uint16_t* cells, unsigned stride, const lockstep_units& units, std::uint16_t* contradictions)
+{
+    using vector = typename Lanes::vector;
+
+    const auto all = Lanes::broadcast(LockstepAllDigits);
+    auto contradiction = Lanes::zero();
+    for (;;)
+    {
+        auto changed = Lanes::zero();
+        for (const auto& unit : units)
+        {
+            // The digits placed in the unit, and the candidates which occur
+            // once or more than once.
+            auto placed = Lanes::zero();
+            auto once = Lanes::zero();
+            auto more = Lanes::zero();
+            for (const auto cell : unit)
+            {
+                const vector candidates = Lanes::load(cells + cell * stride);
+                const auto single = Lanes::singles(candidates);
+
+                // Twice the same digit, or a cell where none fits.
+                contradiction = Lanes::bit_or(contradiction, Lanes::bit_and(placed, single));
+                contradiction = Lanes::bit_or(contradiction, Lanes::is_zero(candidates));
+
+                placed = Lanes::bit_or(placed, single);
+                more = Lanes::bit_or(more, Lanes::bit_and(once, candidates));
+                once = Lanes::bit_or(once, candidates);
+            }
+
+            // A digit which fits nowhere in the unit.
+            contradiction = Lanes::bit_or(contradiction, Lanes::and_not(all, once));
+
+            const auto hidden = Lanes::and_not(Lanes::and_not(once, more), placed);
+            for (const auto cell : unit)
+            {
+                auto* const p = cells + cell * stride;
+                const vector candidates = Lanes::load(p);
+
+                // The placed digits go from the other cells, then a hidden
+                // single is all that's left of its cell.
+                auto next = Lanes::bit_or(Lanes::and_not(candidates, placed), Lanes::singles(candidates));
+                const auto hiddenSingle = Lanes::bit_and(next, hidden);
+                next = Lanes::select(Lanes::is_zero(hiddenSingle), next, hiddenSingle);
+
+                changed = Lanes::bit_or(changed, Lanes::bit_xor(next, candidates));
+                Lanes::store(p, next);
+            }
+        }
+
+        // Candidates only ever go, so this ends.
+        if (!Lanes::any(changed))
+            break;
+    }
+
+    Lanes::store(contradictions, contradiction);
+}
+
+/// @brief Whether the library was built with lockstep_propagate_avx2().
+bool lockstep_avx2_built() noexcept;
+
+/// @brief lockstep_propagate() on 16 grids with AVX2. Only to be called
+/// if lockstep_avx2_built() and the CPU supports AVX2.
+void lockstep_propagate_avx2(std::uint16_t* cells, unsigned stride, const lockstep_units& units, std::uint16_t* contradictions);
@@ -0,0 +1,330 @@
+#include "LockstepSolver.h"
+
+#include "ConstrainSolver.h"
+#include "DigitMask.h"
+#include "GridLayout.h"
+#include "LockstepKernel.h"
+
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#endif
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#endif
+
+namespace
+{
+
+struct ScalarLanes
+{
+    using vector = std::uint16_t;
+
+    static constexpr unsigned Width = 1;
+
+    static vector load(const std::uint16_t* p) noexcept
+    {
+        return *p;
+    }
+
+    static void store(std::uint16_t* p, vector v) noexcept
+    {
+        *p = v;
+    }
+
+    static vector zero() noexcept
+    {
+        return 0;
+    }
+
+    static vector broadcast(std::uint16_t x) noexcept
+    {
+        return x;
+    }
+
+    static vector bit_and(vector a, vector b) noexcept
+    {
+        return static_cast<vector>(a & b);
+    }
+
+    static vector bit_or(vector a, vector b) noexcept
+    {
+        return static_cast<vector>(a | b);
+    }
+
+    static vector bit_xor(vector a, vector b) noexcept
+    {
+        return static_cast<vector>(a ^ b);
+    }
+
+    static vector and_not(vector a, vector b) noexcept
+    {
+        return static_cast<vector>(a & ~b);
+    }
+
+    static vector is_zero(vector v) noexcept
+    {
+        return 0 == v ? 0xFFFF : 0;
+    }
+
+    static vector singles(vector v) noexcept
+    {
+        return 0 == (v & (v - 1)) ? v : 0;
+    }
+
+    static vector select(vector mask, vector a, vector b) noexcept
+    {
+        return 0 != mask ? a : b;
+    }
+
+    static bool any(vector v) noexcept
+    {
+        return 0 != v;
+    }
+};
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+
+// SSE2 is part of x86-64: no need to check the CPU for it.
+constexpr bool HasSse2 = true;
+
+struct Sse2Lanes
+{
+    using vector = __m128i;
+
+    static constexpr unsigned Width = 8;
+
+    static vector load(const std::uint16_t* p) noexcept
+    {
+        return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    }
+
+    static void store(std::uint16_t* p, vector v) noexcept
+    {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v);
+    }
+
+    static vector zero() noexcept
+    {
+        return _mm_setzero_si128();
+    }
+
+    static vector broadcast(std::uint16_t x) noexcept
+    {
+        return _mm_set1_epi16(static_cast<short>(x));
+    }
+
+    static vector bit_and(vector a, vector b) noexcept
+    {
+        return _mm_and_si128(a, b);
+    }
+
+    static vector bit_or(vector a, vector b) noexcept
+    {
+        return _mm_or_si128(a, b);
+    }
+
+    static vector bit_xor(vector a, vector b) noexcept
+    {
+        return _mm_xor_si128(a, b);
+    }
+
+    static vector and_not(vector a, vector b) noexcept
+    {
+        return _mm_andnot_si128(b, a);
+    }
+
+    static vector is_zero(vector v) noexcept
+    {
+        return _mm_cmpeq_epi16(v, zero());
+    }
+
+    static vector singles(vector v) noexcept
+    {
+        const auto lowestCleared = _mm_and_si128(v, _mm_sub_epi16(v, broadcast(1)));
+        return _mm_and_si128(v, is_zero(lowestCleared));
+    }
+
+    // No blend before SSE4.1.
+    static vector select(vector mask, vector a, vector b) noexcept
+    {
+        return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+    }
+
+    static bool any(vector v) noexcept
+    {
+        return 0xFFFF != _mm_movemask_epi8(is_zero(v));
+    }
+};
+
+#else
+
+constexpr bool HasSse2 = false;
+
+// Never picked, see best_instruction_set().
+using Sse2Lanes = ScalarLanes;
+
+#endif
+
+bool cpu_has_avx2() noexcept
+{
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+    __builtin_cpu_init();
+    return 0 != __builtin_cpu_supports("avx2");
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    int info[4] = {};
+    __cpuid(info, 0);
+    if (info[0] < 7)
+        return false;
+
+    // The OS must save the YMM registers, too.
+    __cpuid(info, 1);
+    const auto osxsave = 0 != (info[2] & (1 << 27));
+    if (!osxsave || 6 != (_xgetbv(0) & 6))
+        return false;
+
+    __cpuidex(info, 7, 0);
+    return 0 != (info[1] & (1 << 5));
+#else
+    return false;
+#endif
+}
+
+// The compile-time table itself: the kernel reads cell indices of the same
+// type, in the same order.
+const lockstep_units& units() noexcept
+{
+    return GridLayout::Table.UnitCells;
+}
+
+/// @brief The candidates of a group of grids, one lane per grid.
+struct Group
+{
+    alignas(32) std::uint16_t Cells[LockstepCellCount][LockstepSolver::GroupSize];
+    alignas(32) std::uint16_t Contradictions[LockstepSolver::GroupSize];
+};
+
+template <typename Lanes>
+void propagate(Group& group) noexcept
+{
+    for (unsigned first = 0; first < LockstepSolver::GroupSize; first += Lanes::Width)
+    {
+        lockstep_propagate<Lanes>(&group.Cells[0][first], LockstepSolver::GroupSize, units(), group.Contradictions + first);
+    }
+}
+
+}
+
+LockstepSolver::InstructionSet LockstepSolver::best_instruction_set() noexcept
+{
+    static const auto best = lockstep_avx2_built() && cpu_has_avx2()
+        ? InstructionSet::Avx2
+        : HasSse2 ? InstructionSet::Sse2 : InstructionSet::Scalar;
+
+    return best;
+}
+
+LockstepSolver::LockstepSolver(InstructionSet instructionSet) noexcept
+    : InstructionSet_(std::min(instructionSet, best_instruction_set()))
+{ }
+
+LockstepSolver::InstructionSet LockstepSolver::instructionSet() const noexcept
+{
+    return this->InstructionSet_;
+}
+
+std::vector<BatchResult> LockstepSolver::solve(grid_type* grids, std::size_t count) const
+{
+    std::vector<BatchResult> results(count);
+    this->solve(grids, results.data(), count);
+    return results;
+}
+
+void LockstepSolver::solve(grid_type* grids, BatchResult* results, std::size_t count) const
+{
+    ConstrainSolver fallback;
+    for (std::size_t first = 0; first < count; first += GroupSize)
+    {
+        this->solve_group(grids + first, results + first, std::min<std::size_t>(count - first, GroupSize), fallback);
+    }
+}
+
+void LockstepSolver::solve_group(grid_type* grids, BatchResult* results, std::size_t count, ConstrainSolver& fallback) const
+{
+    // The lanes past count are empty grids, which singles leave as is.
+    Group group;
+    for (unsigned cell = 0; cell < LockstepCellCount; ++cell)
+    {
+        for (unsigned lane = 0; lane < GroupSize; ++lane)
+        {
+            const char value = lane < count ? grids[lane][cell / 9][cell % 9] : 0;
+            group.Cells[cell][lane] = is_empty(value) ? LockstepAllDigits : DigitMask::single(static_cast<unsigned>(value)).bits();
+        }
+    }
+
+    switch (this->InstructionSet_)
+    {
+    case InstructionSet::Avx2:
+        lockstep_propagate_avx2(&group.Cells[0][0], GroupSize, units(), group.Contradictions);
+        break;
+    case InstructionSet::Sse2:
+        propagate<Sse2Lanes>(group);
+        break;
+    default:
+        propagate<ScalarLanes>(group);
+        break;
+    }
+
+    for (unsigned lane = 0; lane < count; ++lane)
+    {
+        auto& grid = grids[lane];
+        auto& result = results[lane];
+        result = BatchResult();
+
+        // Singles are sound: the grid has no solution.
+        if (0 != group.Contradictions[lane])
+            continue;
+
+        bool complete = true;
+        for (unsigned cell = 0; cell < LockstepCellCount; ++cell)
+        {
+            const DigitMask candidates(group.Cells[cell][lane]);
+            auto& value = grid[cell / 9][cell % 9];
+            if (1 != candidates.count())
+            {
+                complete = false;
+            }
+            else if (is_empty(value))
+            {
+                value = static_cast<char>(candidates.lowest());
+                ++result.InsertedDigits;
+            }
+        }
+
+        if (complete)
+        {
+            result.Solved = true;
+            continue;
+        }
+
+        // Singles are stuck: carry on from the digits they placed.
+        fallback.reset(grid);
+        result.Solved = fallback.exec();
+        result.InsertedDigits += fallback.insertedDigits();
+    }
+}
+
+const char* instruction_set_name(LockstepSolver::InstructionSet instructionSet) noexcept
+{
+    switch (instructionSet)
+    {
+    case LockstepSolver::InstructionSet::Avx2:
+        return "avx2";
+    case LockstepSolver::InstructionSet::Sse2:
+        return "sse2";
+    default:
+        return "scalar";
+    }
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "BatchSolver.h"
+#include "SudokuGrid.h"
+#include "fwd/ConstrainSolver.h"
+
+#include <cstddef>
+#include <vector>
+
+/// @brief Solves 9x9 grids sixteen at a time with SIMD instructions.
+///
+/// The candidates of a group of grids are stored cell by cell, with one
+/// 16-bit lane per grid, and naked and hidden singles are propagated on all
+/// the lanes at once until none of them changes. A grid left with a
+/// contradiction has no solution. One which singles couldn't finish drops
+/// out to ConstrainSolver, with the digits found so far.
+///
+/// The instruction set is picked at run time: AVX2 when the CPU has it,
+/// else SSE2 on x86, else plain scalar code, so that the same binary runs
+/// on any machine.
+class LockstepSolver final
+{
+public:
+    using grid_type = SudokuGrid;
+
+    enum class InstructionSet
+    {
+        Scalar,
+        Sse2,
+        Avx2
+    };
+
+    /// @brief Number of grids solved at once.
+    static constexpr unsigned GroupSize = 16;
+
+    /// @brief The widest instruction set this CPU and build support.
+    static InstructionSet best_instruction_set() noexcept;
+
+    /// @param instructionSet Lowered to best_instruction_set() if wider.
+    explicit LockstepSolver(InstructionSet instructionSet = best_instruction_set()) noexcept;
+
+    InstructionSet instructionSet() const noexcept;
+
+    /// @brief Solve @p count grids in place.
+    std::vector<BatchResult> solve(grid_type* grids, std::size_t count) const;
+
+    /// @brief Solve @p count grids in place, into results[0, count).
+    void solve(grid_type* grids, BatchResult* results, std::size_t count) const;
+
+private:
+    /// @param fallback Finishes the grids which singles leave unsolved.
+    void solve_group(grid_type* grids, BatchResult* results, std::size_t count, ConstrainSolver& fallback) const;
+
+    InstructionSet InstructionSet_ = InstructionSet::Scalar;
+};
+
+const char* instruction_set_name(LockstepSolver::InstructionSet instructionSet) noexcept;
@@ -0,0 +1,373 @@
+#include "PackedCorpus.h"
+
+#include "PuzzleReader.h"
+
+#include <cstring>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+
+constexpr char Magic[4] = { 'S', 'D', 'K', 'P' };
+constexpr unsigned char Version = 1;
+constexpr unsigned char SolutionsFlag = 1;
+constexpr std::size_t HeaderSize = 16;
+
+bool supported_side(unsigned side) noexcept
+{
+    return 4 == side || 9 == side || 16 == side || 25 == side;
+}
+
+void write_header(unsigned char* header, unsigned side, bool withSolutions, std::uint64_t count) noexcept
+{
+    std::memcpy(header, Magic, sizeof(Magic));
+    header[4] = Version;
+    header[5] = static_cast<unsigned char>(side);
+    header[6] = withSolutions ? SolutionsFlag : 0;
+    header[7] = static_cast<unsigned char>(packed_cell_bits(side));
+    for (unsigned i = 0; i < 8; ++i)
+    {
+        header[8 + i] = static_cast<unsigned char>(count >> (8 * i));
+    }
+}
+
+std::uint64_t read_count(const unsigned char* header) noexcept
+{
+    std::uint64_t count = 0;
+    for (unsigned i = 0; i < 8; ++i)
+    {
+        count |= static_cast<std::uint64_t>(header[8 + i]) << (8 * i);
+    }
+
+    return count;
+}
+
+/// @return nullptr if the file can't be mapped. An empty file can't.
+const unsigned char* map_file(const char* filePath, std::size_t& size)
+{
+#if defined(_WIN32)
+    const auto file = CreateFileA(filePath, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (INVALID_HANDLE_VALUE == file)
+        return nullptr;
+
+    LARGE_INTEGER fileSize = {};
+    const void* view = nullptr;
+    if (GetFileSizeEx(file, &fileSize) && 0 != fileSize.QuadPart)
+    {
+        // The view keeps the mapping alive once the handles are closed.
+        const auto mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (nullptr != mapping)
+        {
+            view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+            CloseHandle(mapping);
+        }
+    }
+
+    CloseHandle(file);
+    size = static_cast<std::size_t>(fileSize.QuadPart);
+    return static_cast<const unsigned char*>(view);
+#else
+    const auto file = open(filePath, O_RDONLY);
+    if (file < 0)
+        return nullptr;
+
+    struct stat status = {};
+    void* view = MAP_FAILED;
+    if (0 == fstat(file, &status) && 0 != status.st_size)
+    {
+        size = static_cast<std::size_t>(status.st_size);
+        view = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file, 0);
+    }
+
+    // The mapping outlives the descriptor.
+    ::close(file);
+    return MAP_FAILED == view ? nullptr : static_cast<const unsigned char*>(view);
+#endif
+}
+
+void unmap_file(const unsigned char* view, std::size_t size) noexcept
+{
+#if defined(_WIN32)
+    (void)size;
+    UnmapViewOfFile(view);
+#else
+    munmap(const_cast<unsigned char*>(view), size);
+#endif
+}
+
+}
+
+PackedCorpus::PackedCorpus(const char* filePath)
+{
+    this->Mapping_ = map_file(filePath, this->MappingSize_);
+    if (nullptr == this->Mapping_)
+    {
+        this->fail(filePath, "cannot be mapped");
+        return;
+    }
+
+    const auto* const header = this->Mapping_;
+    if (this->MappingSize_ < HeaderSize || 0 != std::memcmp(header, Magic, sizeof(Magic)))
+    {
+        this->fail(filePath, "is not a packed corpus");
+        return;
+    }
+
+    const unsigned side = header[5];
+    if (Version != header[4] || !supported_side(side) || packed_cell_bits(side) != header[7])
+    {
+        this->fail(filePath, "has an unsupported version or grid size");
+        return;
+    }
+
+    const auto hasSolutions = 0 != (header[6] & SolutionsFlag);
+    const auto recordSize = packed_grid_size(side) * (hasSolutions ? 2 : 1);
+    const auto count = read_count(header);
+    if (count > (this->MappingSize_ - HeaderSize) / recordSize)
+    {
+        this->fail(filePath, "is truncated");
+        return;
+    }
+
+    this->Records_ = this->Mapping_ + HeaderSize;
+    this->Size_ = static_cast<std::size_t>(count);
+    this->Side_ = side;
+    this->HasSolutions_ = hasSolutions;
+}
+
+PackedCorpus::~PackedCorpus()
+{
+    if (nullptr != this->Mapping_)
+    {
+        unmap_file(this->Mapping_, this->MappingSize_);
+    }
+}
+
+bool PackedCorpus::failed() const noexcept
+{
+    return !this->ErrorMessage_.empty();
+}
+
+const std::string& PackedCorpus::errorMessage() const noexcept
+{
+    return this->ErrorMessage_;
+}
+
+unsigned PackedCorpus::side() const noexcept
+{
+    return this->Side_;
+}
+
+std::size_t PackedCorpus::size() const noexcept
+{
+    return this->Size_;
+}
+
+bool PackedCorpus::hasSolutions() const noexcept
+{
+    return this->HasSolutions_;
+}
+
+void PackedCorpus::fail(const char* filePath, const char* reason)
+{
+    this->ErrorMessage_ = std::string("Packed corpus '") + filePath + "' " + reason;
+}
+
+PackedCorpusWriter::PackedCorpusWriter(const char* filePath, unsigned side, bool withSolutions)
+    :
+      File_(std::fopen(filePath, "wb")),
+      FilePath_(filePath),
+      Side_(side),
+      WithSolutions_(withSolutions)
+{
+    if (nullptr == this->File_)
+    {
+        this->fail("cannot be written");
+        return;
+    }
+
+    if (!supported_side(side))
+    {
+        this->fail("can't hold grids of this size");
+        return;
+    }
+
+    // The count is filled in by close().
+    unsigned char header[HeaderSize] = {};
+    write_header(header, side, withSolutions, 0);
+    if (HeaderSize != std::fwrite(header, 1, HeaderSize, this->File_))
+    {
+        this->fail("cannot be written");
+    }
+}
+
+PackedCorpusWriter::~PackedCorpusWriter()
+{
+    this->close();
+}
+
+template <unsigned Side>
+bool PackedCorpusWriter::write(const BasicSudokuGrid<Side>& puzzle, const BasicSudokuGrid<Side>* solution)
+{
+    using packed_grid = BasicPackedGrid<Side>;
+
+    if (Side != this->Side_)
+    {
+        this->fail("holds grids of another size");
+        return false;
+    }
+
+    if (this->WithSolutions_ && nullptr == solution)
+    {
+        this->fail("needs a solution for each puzzle");
+        return false;
+    }
+
+    unsigned char record[2 * packed_grid::Size] = {};
+    packed_grid::pack(puzzle, record);
+    if (this->WithSolutions_)
+    {
+        packed_grid::pack(*solution, record + packed_grid::Size);
+    }
+
+    return this->write_record(record, BasicPackedRecords<Side>::record_size(this->WithSolutions_));
+}
+
+bool PackedCorpusWriter::write_record(const unsigned char* record, std::size_t size)
+{
+    if (this->Failed_)
+        return false;
+
+    if (size != std::fwrite(record, 1, size, this->File_))
+    {
+        this->fail("cannot be written");
+        return false;
+    }
+
+    ++(this->Size_);
+    return true;
+}
+
+bool PackedCorpusWriter::close()
+{
+    if (nullptr == this->File_)
+        return !this->Failed_;
+
+    if (!this->Failed_)
+    {
+        unsigned char header[HeaderSize] = {};
+        write_header(header, this->Side_, this->WithSolutions_, this->Size_);
+        if (0 != std::fseek(this->File_, 0, SEEK_SET) || HeaderSize != std::fwrite(header, 1, HeaderSize, this->File_))
+        {
+            this->fail("cannot be written");
+        }
+    }
+
+    if (0 != std::fclose(this->File_))
+    {
+        this->fail("cannot be written");
+    }
+
+    this->File_ = nullptr;
+    return !this->Failed_;
+}
+
+bool PackedCorpusWriter::failed() const noexcept
+{
+    return this->Failed_;
+}
+
+const std::string& PackedCorpusWriter::errorMessage() const noexcept
+{
+    return this->ErrorMessage_;
+}
+
+std::size_t PackedCorpusWriter::size() const noexcept
+{
+    return this->Size_;
+}
+
+void PackedCorpusWriter::fail(const char* reason)
+{
+    // The first error is the one worth telling.
+    if (this->Failed_)
+        return;
+
+    this->Failed_ = true;
+    this->ErrorMessage_ = "Packed corpus '" + this->FilePath_ + "' " + reason;
+}
+
+bool is_packed_corpus(const char* filePath)
+{
+    auto* file = std::fopen(filePath, "rb");
+    if (nullptr == file)
+        return false;
+
+    char magic[sizeof(Magic)] = {};
+    const auto size = std::fread(magic, 1, sizeof(magic), file);
+    std::fclose(file);
+    return sizeof(magic) == size && 0 == std::memcmp(magic, Magic, sizeof(Magic));
+}
+
+template <unsigned Side>
+bool read_puzzles(const char* filePath, std::vector<BasicSudokuGrid<Side>>& grids, std::string& errorMessage)
+{
+    if (!is_packed_corpus(filePath))
+    {
+        PuzzleReader reader(filePath);
+        if (reader.read_all(grids))
+            return true;
+
+        errorMessage = reader.errorMessage();
+        return false;
+    }
+
+    const PackedCorpus corpus(filePath);
+    if (corpus.failed())
+    {
+        errorMessage = corpus.errorMessage();
+        return false;
+    }
+
+    if (Side != corpus.side())
+    {
+        errorMessage = std::string("Packed corpus '") + filePath + "' holds grids of another size";
+        return false;
+    }
+
+    const auto records = corpus.records<Side>();
+    const auto first = grids.size();
+    grids.resize(first + records.size());
+    for (std::size_t i = 0; i < records.size(); ++i)
+    {
+        if (!records[i].puzzle().unpack(grids[first + i]))
+        {
+            grids.resize(first);
+            errorMessage = std::string("Packed corpus '") + filePath + "' has an invalid cell in record " + std::to_string(i + 1);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+template bool PackedCorpusWriter::write(const BasicSudokuGrid<4>&, const BasicSudokuGrid<4>*);
+template bool PackedCorpusWriter::write(const BasicSudokuGrid<9>&, const BasicSudokuGrid<9>*);
+template bool PackedCorpusWriter::write(const BasicSudokuGrid<16>&, const BasicSudokuGrid<16>*);
+template bool PackedCorpusWriter::write(const BasicSudokuGrid<25>&, const BasicSudokuGrid<25>*);
+
+template bool read_puzzles(const char*, std::vector<BasicSudokuGrid<4>>&, std::string&);
+template bool read_puzzles(const char*, std::vector<BasicSudokuGrid<9>>&, std::string&);
+template bool read_puzzles(const char*, std::vector<BasicSudokuGrid<16>>&, std::string&);
+template bool read_puzzles(const char*, std::vector<BasicSudokuGrid<25>>&, std::string&);
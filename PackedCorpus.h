@@ -0,0 +1,436 @@
+#pragma once
+
+#include "SudokuGrid.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <iterator>
+#include <string>
+#include <vector>
+
+// A packed corpus file is a 16-byte header followed by fixed-size records.
+//
+// The header holds the magic "SDKP", the format version, the grid side,
+// the flags (bit 0: each puzzle is followed by its solution), the number of
+// bits per cell and the number of records, as a little-endian 64-bit count.
+//
+// A grid is stored row by row, a cell per nibble (high nibble first) up to
+// 9x9, and a cell per byte past that: a 9x9 grid takes 41 bytes.
+
+/// @brief Number of bits per cell of a packed Side x Side grid.
+constexpr unsigned packed_cell_bits(unsigned side) noexcept
+{
+    return side < 16 ? 4 : 8;
+}
+
+/// @brief Number of bytes of a packed Side x Side grid.
+constexpr std::size_t packed_grid_size(unsigned side) noexcept
+{
+    return (side * side * packed_cell_bits(side) + 7) / 8;
+}
+
+/// @brief A grid stored in a packed corpus, read in place.
+template <unsigned Side>
+class BasicPackedGrid final
+{
+public:
+    using grid_type = BasicSudokuGrid<Side>;
+
+    static constexpr std::size_t Size = packed_grid_size(Side);
+
+    explicit BasicPackedGrid(const unsigned char* data) noexcept
+        : Data_(data)
+    { }
+
+    char cell(unsigned row, unsigned column) const noexcept
+    {
+        return this->cell(row * Side + column);
+    }
+
+    /// @brief Copy the cells to @p grid.
+    /// @return false if a cell is above Side: the file is corrupt, and
+    /// @p grid mustn't be used.
+    bool unpack(grid_type& grid) const noexcept
+    {
+        auto* cells = &grid[0][0];
+        if (8 == packed_cell_bits(Side))
+        {
+            unsigned char largest = 0;
+            for (unsigned i = 0; i < Side * Side; ++i)
+            {
+                const auto value = this->Data_[i];
+                largest = value > largest ? value : largest;
+                cells[i] = static_cast<char>(value);
+            }
+
+            return largest <= Side;
+        }
+
+        // Two cells per byte, then the odd one out.
+        constexpr unsigned pairs = Side * Side / 2;
+        unsigned largest = 0;
+        for (unsigned i = 0; i < pairs; ++i)
+        {
+            const unsigned high = this->Data_[i] >> 4;
+            const unsigned low = this->Data_[i] & 0xFU;
+            largest = std::max(largest, std::max(high, low));
+            cells[2 * i] = static_cast<char>(high);
+            cells[2 * i + 1] = static_cast<char>(low);
+        }
+
+        if (0 != Side * Side % 2)
+        {
+            const unsigned last = this->Data_[pairs] >> 4;
+            largest = std::max(largest, last);
+            cells[2 * pairs] = static_cast<char>(last);
+        }
+
+        return largest <= Side;
+    }
+
+    /// @brief Write @p grid to the Size bytes at @p data.
+    static void pack(const grid_type& grid, unsigned char* data) noexcept
+    {
+        const auto* cells = &grid[0][0];
+        if (8 == packed_cell_bits(Side))
+        {
+            for (unsigned i = 0; i < Side * Side; ++i)
+            {
+                data[i] = static_cast<unsigned char>(cells[i]);
+            }
+
+            return;
+        }
+
+        for (unsigned i = 0; i < Size; ++i)
+        {
+            const auto high = static_cast<unsigned>(cells[2 * i]);
+            const auto low = 2 * i + 1 < Side * Side ? static_cast<unsigned>(cells[2 * i + 1]) : 0;
+            data[i] = static_cast<unsigned char>((high << 4) | low);
+        }
+    }
+
+private:
+    char cell(unsigned i) const noexcept
+    {
+        if (8 == packed_cell_bits(Side))
+            return static_cast<char>(this->Data_[i]);
+
+        const auto byte = this->Data_[i / 2];
+        return static_cast<char>(0 == i % 2 ? byte >> 4 : byte & 0xF);
+    }
+
+    const unsigned char* Data_ = nullptr;
+};
+
+/// @brief A puzzle of a packed corpus, and its solution if the corpus has
+/// them.
+template <unsigned Side>
+class BasicPackedRecord final
+{
+public:
+    BasicPackedRecord(const unsigned char* data, bool hasSolution) noexcept
+        :
+          Data_(data),
+          HasSolution_(hasSolution)
+    { }
+
+    BasicPackedGrid<Side> puzzle() const noexcept
+    {
+        return BasicPackedGrid<Side>(this->Data_);
+    }
+
+    bool hasSolution() const noexcept
+    {
+        return this->HasSolution_;
+    }
+
+    /// @pre hasSolution()
+    BasicPackedGrid<Side> solution() const noexcept
+    {
+        return BasicPackedGrid<Side>(this->Data_ + BasicPackedGrid<Side>::Size);
+    }
+
+private:
+    const unsigned char* Data_ = nullptr;
+    bool HasSolution_ = false;
+};
+
+/// @brief The records of a packed corpus, as a random-access range of
+/// views into the mapped file.
+template <unsigned Side>
+class BasicPackedRecords final
+{
+public:
+    using value_type = BasicPackedRecord<Side>;
+
+    class const_iterator final
+    {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = BasicPackedRecord<Side>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = value_type;
+
+        const_iterator() noexcept = default;
+
+        const_iterator(const unsigned char* data, bool hasSolutions, std::size_t index) noexcept
+            :
+              Data_(data),
+              HasSolutions_(hasSolutions),
+              Index_(static_cast<difference_type>(index))
+        { }
+
+        reference operator*() const noexcept
+        {
+            return value_type(this->Data_ + static_cast<std::size_t>(this->Index_) * record_size(this->HasSolutions_), this->HasSolutions_);
+        }
+
+        reference operator[](difference_type n) const noexcept
+        {
+            return *(*this + n);
+        }
+
+        const_iterator& operator++() noexcept
+        {
+            ++(this->Index_);
+            return *this;
+        }
+
+        const_iterator operator++(int) noexcept
+        {
+            auto old = *this;
+            ++(this->Index_);
+            return old;
+        }
+
+        const_iterator& operator--() noexcept
+        {
+            --(this->Index_);
+            return *this;
+        }
+
+        const_iterator operator--(int) noexcept
+        {
+            auto old = *this;
+            --(this->Index_);
+            return old;
+        }
+
+        const_iterator& operator+=(difference_type n) noexcept
+        {
+            this->Index_ += n;
+            return *this;
+        }
+
+        const_iterator& operator-=(difference_type n) noexcept
+        {
+            this->Index_ -= n;
+            return *this;
+        }
+
+        friend const_iterator operator+(const_iterator it, difference_type n) noexcept
+        {
+            return it += n;
+        }
+
+        friend const_iterator operator+(difference_type n, const_iterator it) noexcept
+        {
+            return it += n;
+        }
+
+        friend const_iterator operator-(const_iterator it, difference_type n) noexcept
+        {
+            return it -= n;
+        }
+
+        friend difference_type operator-(const const_iterator& lhs, const const_iterator& rhs) noexcept
+        {
+            return lhs.Index_ - rhs.Index_;
+        }
+
+        friend bool operator==(const const_iterator& lhs, const const_iterator& rhs) noexcept
+        {
+            return lhs.Index_ == rhs.Index_;
+        }
+
+        friend bool operator!=(const const_iterator& lhs, const const_iterator& rhs) noexcept
+        {
+            return lhs.Index_ != rhs.Index_;
+        }
+
+        friend bool operator<(const const_iterator& lhs, const const_iterator& rhs) noexcept
+        {
+            return lhs.Index_ < rhs.Index_;
+        }
+
+        friend bool operator>(const const_iterator& lhs, const const_iterator& rhs) noexcept
+        {
+            return rhs < lhs;
+        }
+
+        friend bool operator<=(const const_iterator& lhs, const const_iterator& rhs) noexcept
+        {
+            return !(rhs < lhs);
+        }
+
+        friend bool operator>=(const const_iterator& lhs, const const_iterator& rhs) noexcept
+        {
+            return !(lhs < rhs);
+        }
+
+    private:
+        const unsigned char* Data_ = nullptr;
+        bool HasSolutions_ = false;
+        difference_type Index_ = 0;
+    };
+
+    BasicPackedRecords() noexcept = default;
+
+    BasicPackedRecords(const unsigned char* data, std::size_t size, bool hasSolutions) noexcept
+        :
+          Data_(data),
+          Size_(size),
+          HasSolutions_(hasSolutions)
+    { }
+
+    std::size_t size() const noexcept
+    {
+        return this->Size_;
+    }
+
+    bool empty() const noexcept
+    {
+        return 0 == this->Size_;
+    }
+
+    value_type operator[](std::size_t i) const noexcept
+    {
+        return value_type(this->Data_ + i * record_size(this->HasSolutions_), this->HasSolutions_);
+    }
+
+    const_iterator begin() const noexcept
+    {
+        return const_iterator(this->Data_, this->HasSolutions_, 0);
+    }
+
+    const_iterator end() const noexcept
+    {
+        return const_iterator(this->Data_, this->HasSolutions_, this->Size_);
+    }
+
+    static constexpr std::size_t record_size(bool hasSolutions) noexcept
+    {
+        return BasicPackedGrid<Side>::Size * (hasSolutions ? 2 : 1);
+    }
+
+private:
+    const unsigned char* Data_ = nullptr;
+    std::size_t Size_ = 0;
+    bool HasSolutions_ = false;
+};
+
+/// @brief A packed corpus file, mapped in memory for as long as the object
+/// lives: its records are read in place, without parsing nor copying.
+class PackedCorpus final
+{
+public:
+    explicit PackedCorpus(const char* filePath);
+
+    PackedCorpus(const PackedCorpus&) = delete;
+    PackedCorpus(PackedCorpus&&) = delete;
+
+    PackedCorpus& operator=(const PackedCorpus&) = delete;
+    PackedCorpus& operator=(PackedCorpus&&) = delete;
+
+    ~PackedCorpus();
+
+    bool failed() const noexcept;
+
+    /// @brief A human-readable description of the error.
+    const std::string& errorMessage() const noexcept;
+
+    unsigned side() const noexcept;
+    std::size_t size() const noexcept;
+    bool hasSolutions() const noexcept;
+
+    /// @return The records, or none if the grids aren't Side x Side.
+    template <unsigned Side>
+    BasicPackedRecords<Side> records() const noexcept
+    {
+        if (this->failed() || Side != this->Side_)
+            return BasicPackedRecords<Side>();
+
+        return BasicPackedRecords<Side>(this->Records_, this->Size_, this->HasSolutions_);
+    }
+
+private:
+    void fail(const char* filePath, const char* reason);
+
+    const unsigned char* Mapping_ = nullptr;
+    std::size_t MappingSize_ = 0;
+
+    const unsigned char* Records_ = nullptr;
+    std::size_t Size_ = 0;
+    unsigned Side_ = 0;
+    bool HasSolutions_ = false;
+
+    std::string ErrorMessage_;
+};
+
+/// @brief Writes a packed corpus file, one record at a time.
+///
+/// The record count in the header is written by close(), or by the
+/// destructor.
+class PackedCorpusWriter final
+{
+public:
+    /// @param withSolutions Whether each puzzle is followed by its solution.
+    PackedCorpusWriter(const char* filePath, unsigned side, bool withSolutions);
+
+    PackedCorpusWriter(const PackedCorpusWriter&) = delete;
+    PackedCorpusWriter(PackedCorpusWriter&&) = delete;
+
+    PackedCorpusWriter& operator=(const PackedCorpusWriter&) = delete;
+    PackedCorpusWriter& operator=(PackedCorpusWriter&&) = delete;
+
+    ~PackedCorpusWriter();
+
+    /// @param solution Ignored without solutions, required with them.
+    template <unsigned Side>
+    bool write(const BasicSudokuGrid<Side>& puzzle, const BasicSudokuGrid<Side>* solution = nullptr);
+
+    /// @brief Write the header and close the file.
+    /// @return false if anything failed to be written.
+    bool close();
+
+    bool failed() const noexcept;
+    const std::string& errorMessage() const noexcept;
+
+    std::size_t size() const noexcept;
+
+private:
+    bool write_record(const unsigned char* record, std::size_t size);
+    void fail(const char* reason);
+
+    std::FILE* File_ = nullptr;
+    std::string FilePath_;
+    unsigned Side_ = 0;
+    bool WithSolutions_ = false;
+    std::size_t Size_ = 0;
+
+    bool Failed_ = false;
+    std::string ErrorMessage_;
+};
+
+/// @brief Whether @p filePath starts like a packed corpus.
+bool is_packed_corpus(const char* filePath);
+
+/// @brief Append all the puzzles of @p filePath, a packed corpus or a text
+/// file (see PuzzleReader), to @p grids.
+/// @return false on error, described by @p errorMessage.
+template <unsigned Side>
+bool read_puzzles(const char* filePath, std::vector<BasicSudokuGrid<Side>>& grids, std::string& errorMessage);
@@ -0,0 +1,342 @@
+#include "PuzzleGenerator.h"
+
+#include "BacktrackingSolver.h"
+#include "BatchSolver.h"
+#include "CandidateBoard.h"
+#include "Deduction.h"
+#include "DigitMask.h"
+#include "GridLayout.h"
+#include "TechniquePipeline.h"
+
+#include <algorithm>
+#include <cstring>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace
+{
+
+const char* const SymmetryNames[] = {
+    "none",
+    "rotational",
+    "mirror",
+    "diagonal"
+};
+
+/// @brief A well mixed seed for the generator of the @p index-th grid
+/// (SplitMix64), so that neighbouring indices give unrelated grids.
+std::uint64_t grid_seed(std::uint64_t seed, std::uint64_t index) noexcept
+{
+    auto z = seed + (index + 1) * 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+// std::shuffle and the standard distributions differ between standard
+// libraries: these don't, so that a seed gives the same grids everywhere.
+unsigned random_below(std::mt19937_64& random, unsigned bound)
+{
+    return static_cast<unsigned>(random() % bound);
+}
+
+template <typename T>
+void random_shuffle(T* first, unsigned count, std::mt19937_64& random)
+{
+    for (auto i = count; i > 1; --i)
+    {
+        std::swap(first[i - 1], first[random_below(random, i)]);
+    }
+}
+
+/// @brief Fills an empty grid at random, by a backtracking search on the
+/// cell with the fewest candidates, trying its digits in a random order.
+template <unsigned Side>
+class GridFiller final
+{
+public:
+    GridFiller(BasicSudokuGrid<Side>& grid, std::mt19937_64& random)
+        :
+          Grid_(grid),
+          Random_(random)
+    {
+        for (unsigned cell = 0; cell < CellCount; ++cell)
+        {
+            this->EmptyCells_[cell] = cell;
+        }
+    }
+
+    /// @return false if the search took more than @p budget nodes: an
+    /// unlucky start is better started over than searched through.
+    bool fill(unsigned long budget)
+    {
+        this->Budget_ = budget;
+        return this->search(CellCount);
+    }
+
+private:
+    using mask_type = BasicDigitMask<Side>;
+    static constexpr unsigned CellCount = Side * Side;
+    using layout_type = BasicGridLayout<Side>;
+
+    mask_type candidates(unsigned cell) const noexcept
+    {
+        return and_not(mask_type::all(), this->Rows_[cell / Side] | this->Columns_[cell % Side] | this->Subgrids_[layout_type::subgrid(cell)]);
+    }
+
+    void set(unsigned cell, unsigned digit) noexcept
+    {
+        this->Rows_[cell / Side].insert(digit);
+        this->Columns_[cell % Side].insert(digit);
+        this->Subgrids_[layout_type::subgrid(cell)].insert(digit);
+        this->Grid_[cell / Side][cell % Side] = static_cast<char>(digit);
+    }
+
+    void unset(unsigned cell, unsigned digit) noexcept
+    {
+        this->Rows_[cell / Side].erase(digit);
+        this->Columns_[cell % Side].erase(digit);
+        this->Subgrids_[layout_type::subgrid(cell)].erase(digit);
+        this->Grid_[cell / Side][cell % Side] = 0;
+    }
+
+    bool search(unsigned remaining)
+    {
+        if (0 == remaining)
+            return true;
+
+        if (0 == this->Budget_)
+            return false;
+
+        --this->Budget_;
+
+        unsigned best = 0;
+        unsigned bestCount = Side + 1;
+        mask_type bestCandidates;
+        for (unsigned i = 0; i < remaining && bestCount > 1; ++i)
+        {
+            const auto candidates = this->candidates(this->EmptyCells_[i]);
+            const auto count = candidates.count();
+            if (count < bestCount)
+            {
+                best = i;
+                bestCount = count;
+                bestCandidates = candidates;
+            }
+        }
+
+        if (0 == bestCount)
+            return false;
+
+        std::swap(this->EmptyCells_[best], this->EmptyCells_[remaining - 1]);
+        const auto cell = this->EmptyCells_[remaining - 1];
+
+        unsigned digits[Side] = {};
+        unsigned count = 0;
+        for (auto remainingDigits = bestCandidates; !remainingDigits.empty(); )
+        {
+            digits[count++] = remainingDigits.pop_lowest();
+        }
+        random_shuffle(digits, count, this->Random_);
+
+        for (unsigned i = 0; i < count; ++i)
+        {
+            this->set(cell, digits[i]);
+            if (this->search(remaining - 1))
+                return true;
+
+            this->unset(cell, digits[i]);
+        }
+
+        return false;
+    }
+
+    BasicSudokuGrid<Side>& Grid_;
+    std::mt19937_64& Random_;
+
+    mask_type Rows_[Side];
+    mask_type Columns_[Side];
+    mask_type Subgrids_[Side];
+
+    // The cells still to fill come first.
+    unsigned EmptyCells_[CellCount] = {};
+    unsigned long Budget_ = 0;
+};
+
+template <unsigned Side>
+void fill_random(BasicSudokuGrid<Side>& grid, std::mt19937_64& random)
+{
+    for (unsigned long budget = 4 * Side * Side; ; budget *= 2)
+    {
+        std::fill(grid.begin(), grid.end(), 0);
+        if (GridFiller<Side>(grid, random).fill(budget))
+            return;
+    }
+}
+
+/// @brief Whether the solving techniques fill @p grid in without a guess,
+/// which proves that its solution is unique.
+template <unsigned Side>
+bool solves_without_guessing(BasicSudokuGrid<Side> grid)
+{
+    BasicCandidateBoard<Side> board(grid);
+    BasicTechniquePipeline<Side> pipeline;
+    BasicDeduction<Side> deduction;
+    while (!board.contradiction() && pipeline.find(board, deduction))
+    {
+        board.apply(deduction);
+    }
+
+    return !board.contradiction() && std::none_of(grid.begin(), grid.end(), is_empty);
+}
+
+/// @brief Whether @p puzzle, made from a full grid, still has a single
+/// solution.
+///
+/// Past 9x9, looking for a second solution of a sparse grid can take
+/// ages: a puzzle must then be solved by the techniques alone, which
+/// leaves more clues.
+template <unsigned Side>
+bool has_unique_solution(const BasicSudokuGrid<Side>& puzzle)
+{
+    return Side <= SudokuGridSide ? 1 == count_solutions(puzzle, 2) : solves_without_guessing(puzzle);
+}
+
+/// @brief The cell which @p symmetry pairs with @p cell (maybe itself).
+template <unsigned Side>
+unsigned symmetric_cell(unsigned cell, ClueSymmetry symmetry) noexcept
+{
+    const auto row = cell / Side;
+    const auto column = cell % Side;
+    switch (symmetry)
+    {
+    case ClueSymmetry::Rotational:
+        return Side * Side - 1 - cell;
+    case ClueSymmetry::Mirror:
+        return row * Side + Side - 1 - column;
+    case ClueSymmetry::Diagonal:
+        return column * Side + row;
+    default:
+        return cell;
+    }
+}
+
+}
+
+const char* symmetry_name(ClueSymmetry symmetry) noexcept
+{
+    return SymmetryNames[static_cast<unsigned>(symmetry)];
+}
+
+bool parse_symmetry(const char* name, ClueSymmetry& symmetry) noexcept
+{
+    for (unsigned i = 0; i < sizeof(SymmetryNames) / sizeof(SymmetryNames[0]); ++i)
+    {
+        if (0 == std::strcmp(name, SymmetryNames[i]))
+        {
+            symmetry = static_cast<ClueSymmetry>(i);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+template <unsigned Side>
+BasicPuzzleGenerator<Side>::BasicPuzzleGenerator(std::uint64_t seed, GeneratorOptions options) noexcept
+    :
+      Seed_(seed),
+      Options_(options)
+{ }
+
+template <unsigned Side>
+std::uint64_t BasicPuzzleGenerator<Side>::seed() const noexcept
+{
+    return this->Seed_;
+}
+
+template <unsigned Side>
+const GeneratorOptions& BasicPuzzleGenerator<Side>::options() const noexcept
+{
+    return this->Options_;
+}
+
+template <unsigned Side>
+void BasicPuzzleGenerator<Side>::fill_solution(std::uint64_t index, grid_type& grid) const
+{
+    std::mt19937_64 random(grid_seed(this->Seed_, index));
+    fill_random(grid, random);
+}
+
+template <unsigned Side>
+unsigned BasicPuzzleGenerator<Side>::generate(std::uint64_t index, grid_type& puzzle) const
+{
+    constexpr auto cellCount = Side * Side;
+
+    // The same random numbers as fill_solution(), then the ones for the
+    // order in which the clues go.
+    std::mt19937_64 random(grid_seed(this->Seed_, index));
+    fill_random(puzzle, random);
+
+    unsigned order[cellCount] = {};
+    for (unsigned cell = 0; cell < cellCount; ++cell)
+    {
+        order[cell] = cell;
+    }
+    random_shuffle(order, cellCount, random);
+
+    const auto target = this->Options_.TargetClues;
+    auto clues = cellCount;
+    for (const auto cell : order)
+    {
+        if (clues <= target)
+            break;
+
+        auto& value = puzzle[cell / Side][cell % Side];
+        if (is_empty(value))
+            continue;
+
+        // The symmetric cell goes along, and is still a clue as removals
+        // are symmetric, too.
+        const auto other = symmetric_cell<Side>(cell, this->Options_.Symmetry);
+        auto& otherValue = puzzle[other / Side][other % Side];
+        const auto removed = other == cell ? 1U : 2U;
+        if (clues - removed < target)
+            continue;
+
+        const auto saved = value;
+        const auto otherSaved = otherValue;
+        value = 0;
+        otherValue = 0;
+        if (has_unique_solution(puzzle))
+        {
+            clues -= removed;
+        }
+        else
+        {
+            value = saved;
+            otherValue = otherSaved;
+        }
+    }
+
+    return clues;
+}
+
+template <unsigned Side>
+void BasicPuzzleGenerator<Side>::generate_many(std::uint64_t first, std::size_t count, grid_type* puzzles, unsigned threadCount) const
+{
+    // A puzzle takes long enough for the workers to take one at a time.
+    parallel_for(count, 1, threadCount, [this, first, puzzles](std::size_t begin, std::size_t end)
+    {
+        for (auto i = begin; i < end; ++i)
+        {
+            this->generate(first + i, puzzles[i]);
+        }
+    });
+}
+
+template class BasicPuzzleGenerator<4>;
+template class BasicPuzzleGenerator<9>;
+template class BasicPuzzleGenerator<16>;
+template class BasicPuzzleGenerator<25>;
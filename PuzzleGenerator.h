@@ -0,0 +1,79 @@
+#pragma once
+
+#include "SudokuGrid.h"
+
+#include <cstddef>
+#include <cstdint>
+
+/// @brief How the clues of a generated puzzle are laid out.
+enum class ClueSymmetry
+{
+    None,
+
+    /// Unchanged by a half turn around the center.
+    Rotational,
+
+    /// Unchanged by a left-right flip.
+    Mirror,
+
+    /// Unchanged by a flip around the main diagonal.
+    Diagonal
+};
+
+/// @brief The name of @p symmetry, as accepted by parse_symmetry().
+const char* symmetry_name(ClueSymmetry symmetry) noexcept;
+
+/// @return false on an unknown name; @p symmetry is left unchanged.
+bool parse_symmetry(const char* name, ClueSymmetry& symmetry) noexcept;
+
+struct GeneratorOptions
+{
+    ClueSymmetry Symmetry = ClueSymmetry::None;
+
+    /// Stop removing clues once there are this many left. With 0, clues
+    /// are removed until none can go without losing uniqueness.
+    unsigned TargetClues = 0;
+};
+
+/// @brief Generates random puzzles with a unique solution.
+///
+/// A full grid is filled in at random, then its clues are taken away in a
+/// random order, together with their symmetric cells, as long as
+/// count_solutions() still finds a single solution. Past 9x9, where that
+/// search gets too slow, a clue only goes if the solving techniques still
+/// fill the grid in without guessing.
+///
+/// Every grid depends on the seed and on its index only: generating the
+/// same indices again, on any number of threads, gives the same grids.
+/// The generator has no mutable state, and can be shared between threads.
+template <unsigned Side>
+class BasicPuzzleGenerator final
+{
+public:
+    using grid_type = BasicSudokuGrid<Side>;
+
+    explicit BasicPuzzleGenerator(std::uint64_t seed, GeneratorOptions options = GeneratorOptions()) noexcept;
+
+    std::uint64_t seed() const noexcept;
+    const GeneratorOptions& options() const noexcept;
+
+    /// @brief Fill @p grid with the @p index-th random full grid.
+    void fill_solution(std::uint64_t index, grid_type& grid) const;
+
+    /// @brief Make the @p index-th puzzle, whose solution is
+    /// fill_solution(index).
+    /// @return The number of clues, which is above the target clue count
+    /// if no more clues could go.
+    unsigned generate(std::uint64_t index, grid_type& puzzle) const;
+
+    /// @brief Make the puzzles [first, first + count) into @p puzzles.
+    /// @param threadCount Number of threads (the calling thread included).
+    ///                    If 0, one per hardware thread is used.
+    void generate_many(std::uint64_t first, std::size_t count, grid_type* puzzles, unsigned threadCount = 0) const;
+
+private:
+    std::uint64_t Seed_ = 0;
+    GeneratorOptions Options_;
+};
+
+using PuzzleGenerator = BasicPuzzleGenerator<9>;
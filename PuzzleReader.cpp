@@ -0,0 +1,274 @@
+#include "PuzzleReader.h"
+
+#include "PackedCorpus.h"
+#include "SudokuGrid.h"
+
+#include <cstdarg>
+
+namespace
+{
+
+constexpr std::size_t BlockSize = 1U << 16U;
+
+}
+
+PuzzleReader::PuzzleReader(const char* filePath)
+    :
+      File_(std::fopen(filePath, "rb")),
+      Buffer_(BlockSize)
+{
+    if (nullptr == this->File_)
+    {
+        this->fail(0, "Invalid input file '%s'", filePath);
+    }
+}
+
+PuzzleReader::~PuzzleReader()
+{
+    if (nullptr != this->File_)
+    {
+        std::fclose(this->File_);
+    }
+}
+
+bool PuzzleReader::is_open() const noexcept
+{
+    return nullptr != this->File_;
+}
+
+bool PuzzleReader::failed() const noexcept
+{
+    return this->Failed_;
+}
+
+unsigned PuzzleReader::errorLine() const noexcept
+{
+    return this->ErrorLine_;
+}
+
+const std::string& PuzzleReader::errorMessage() const noexcept
+{
+    return this->ErrorMessage_;
+}
+
+bool PuzzleReader::refill()
+{
+    this->BufferOffset_ += this->Size_;
+    this->Position_ = 0;
+    this->Size_ = std::fread(this->Buffer_.data(), 1, this->Buffer_.size(), this->File_);
+    return 0 != this->Size_;
+}
+
+void PuzzleReader::fail(unsigned line, const char* format, ...)
+{
+    this->Failed_ = true;
+    this->ErrorLine_ = line;
+
+    char message[256];
+
+    va_list args;
+    va_start(args, format);
+    std::vsnprintf(message, sizeof(message), format, args);
+    va_end(args);
+
+    this->ErrorMessage_ = message;
+}
+
+template <unsigned Side>
+bool PuzzleReader::end_line()
+{
+    constexpr auto cellCount = BasicSudokuGrid<Side>::size();
+
+    const auto cells = this->LineCells_;
+    this->LineCells_ = 0;
+    if (0 == cells || Side == cells || cellCount == cells)
+        return true;
+
+    this->fail(this->Line_,
+        "Invalid input: line %u holds %u cells, instead of %u (a grid row) or %u (a whole grid)",
+        this->Line_, cells, Side, cellCount);
+    return false;
+}
+
+template <unsigned Side>
+bool PuzzleReader::read(BasicSudokuGrid<Side>& grid)
+{
+    if (this->Failed_)
+        return false;
+
+    constexpr auto cellCount = BasicSudokuGrid<Side>::size();
+
+    auto cells = grid.begin();
+    unsigned count = 0;
+    while (count < cellCount)
+    {
+        if (this->Position_ == this->Size_ && !this->refill())
+        {
+            // The last line may have no line break.
+            if (!this->end_line<Side>())
+                return false;
+
+            if (0 != count)
+            {
+                this->fail(this->Line_,
+                    "Unexpected end of input at line %u: the last grid has only %u of %u cells",
+                    this->Line_, count, cellCount);
+            }
+
+            return false;
+        }
+
+        const char* const data = this->Buffer_.data();
+        auto i = this->Position_;
+        for (; i < this->Size_ && count < cellCount; ++i)
+        {
+            const auto c = data[i];
+            const auto value = from_symbol(c);
+            if (0 <= value && value <= static_cast<int>(Side))
+            {
+                if (0 == this->LineCells_)
+                {
+                    this->LineStart_ = count;
+                }
+
+                // Only a line starting a grid may hold more than a row,
+                // and no line more than a grid: told before the grid is
+                // returned.
+                const auto lineSize = 0 == this->LineStart_ ? cellCount : Side;
+                if (lineSize == this->LineCells_)
+                {
+                    this->fail(this->Line_,
+                        "Invalid input: line %u holds more than %u cells (%s)",
+                        this->Line_, lineSize, 0 == this->LineStart_ ? "a whole grid" : "a grid row");
+                    return false;
+                }
+
+                ++this->LineCells_;
+                cells[count++] = static_cast<char>(value);
+            }
+            else if ('\n' == c)
+            {
+                if (!this->end_line<Side>())
+                    return false;
+
+                ++this->Line_;
+                this->LineOffset_ = this->BufferOffset_ + i + 1;
+            }
+            else if (' ' != c && '\t' != c && '\r' != c)
+            {
+                const auto column = this->BufferOffset_ + i - this->LineOffset_ + 1;
+                this->fail(this->Line_,
+                    "Invalid input: '%c' at line %u, column %zu",
+                    c, this->Line_, column);
+                return false;
+            }
+        }
+
+        this->Position_ = i;
+    }
+
+    return true;
+}
+
+template <unsigned Side>
+bool PuzzleReader::read_all(std::vector<BasicSudokuGrid<Side>>& grids)
+{
+    BasicSudokuGrid<Side> grid;
+    while (this->read(grid))
+    {
+        grids.push_back(grid);
+    }
+
+    return !this->Failed_;
+}
+
+template bool PuzzleReader::read(BasicSudokuGrid<4>&);
+template bool PuzzleReader::read(BasicSudokuGrid<9>&);
+template bool PuzzleReader::read(BasicSudokuGrid<16>&);
+template bool PuzzleReader::read(BasicSudokuGrid<25>&);
+
+template bool PuzzleReader::read_all(std::vector<BasicSudokuGrid<4>>&);
+template bool PuzzleReader::read_all(std::vector<BasicSudokuGrid<9>>&);
+template bool PuzzleReader::read_all(std::vector<BasicSudokuGrid<16>>&);
+template bool PuzzleReader::read_all(std::vector<BasicSudokuGrid<25>>&);
+
+template <unsigned Side>
+void format_grid(const BasicSudokuGrid<Side>& grid, bool spaced, std::string& out)
+{
+    for (unsigned r = 0; r < Side; ++r)
+    {
+        for (unsigned c = 0; c < Side; ++c)
+        {
+            if (spaced && 0 != c)
+            {
+                out.push_back(' ');
+            }
+
+            out.push_back(to_symbol(grid[r][c]));
+        }
+
+        if (spaced)
+        {
+            out.push_back('\n');
+        }
+    }
+
+    // Ends a one-line grid, or leaves a blank line after a spaced one.
+    out.push_back('\n');
+}
+
+template void format_grid(const BasicSudokuGrid<4>&, bool, std::string&);
+template void format_grid(const BasicSudokuGrid<9>&, bool, std::string&);
+template void format_grid(const BasicSudokuGrid<16>&, bool, std::string&);
+template void format_grid(const BasicSudokuGrid<25>&, bool, std::string&);
+
+unsigned detect_grid_side(const char* filePath)
+{
+    if (is_packed_corpus(filePath))
+    {
+        const PackedCorpus corpus(filePath);
+        return corpus.side();
+    }
+
+    auto* file = std::fopen(filePath, "rb");
+    if (nullptr == file)
+        return 0;
+
+    std::vector<char> buffer(BlockSize);
+    const auto size = std::fread(buffer.data(), 1, buffer.size(), file);
+    std::fclose(file);
+
+    unsigned cells = 0;
+    bool afterSpace = false;
+    bool spaced = false;
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        const auto c = buffer[i];
+        if ('\n' == c)
+        {
+            if (0 != cells)
+                break;
+        }
+        else if (' ' == c || '\t' == c)
+        {
+            afterSpace = 0 != cells;
+        }
+        else if (from_symbol(c) >= 0)
+        {
+            spaced = spaced || afterSpace;
+            ++cells;
+        }
+    }
+
+    const unsigned sides[] = { 4, 9, 16, 25 };
+    for (const auto side : sides)
+    {
+        if (side == cells && spaced)
+            return side;
+
+        if (side * side == cells && !spaced)
+            return side;
+    }
+
+    return 0;
+}
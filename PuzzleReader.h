@@ -0,0 +1,95 @@
+#pragma once
+
+#include "fwd/SudokuGrid.h"
+
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+/// @brief Streams the grids stored in a text file.
+///
+/// The file is read in large blocks and the cells are parsed straight into
+/// the grid storage. A grid is made of BasicSudokuGrid::size() consecutive
+/// cells, i.e. digits in [1, Side] (see to_symbol()) and '0' or '.' for the
+/// empty cells. Spaces and tabs between cells are ignored. Each non-empty
+/// line holds either a whole grid or one grid row (the spaced layout), and
+/// both can be mixed in the same file; any other line is an error reported
+/// with its number.
+class PuzzleReader final
+{
+public:
+    explicit PuzzleReader(const char* filePath);
+
+    PuzzleReader(const PuzzleReader&) = delete;
+    PuzzleReader(PuzzleReader&&) = delete;
+
+    PuzzleReader& operator=(const PuzzleReader&) = delete;
+    PuzzleReader& operator=(PuzzleReader&&) = delete;
+
+    ~PuzzleReader();
+
+    bool is_open() const noexcept;
+
+    /// @brief Read the next grid of the file.
+    /// @return false at the end of the input or on error (see failed()).
+    template <unsigned Side>
+    bool read(BasicSudokuGrid<Side>& grid);
+
+    /// @brief Read all the remaining grids of the file and append them to @p grids.
+    /// @return false on error (see failed()).
+    template <unsigned Side>
+    bool read_all(std::vector<BasicSudokuGrid<Side>>& grids);
+
+    bool failed() const noexcept;
+
+    /// @brief The line (1-based) where reading failed.
+    unsigned errorLine() const noexcept;
+
+    /// @brief A human-readable description of the error (including the line).
+    const std::string& errorMessage() const noexcept;
+
+private:
+    bool refill();
+
+    /// @brief Check the line just read holds a grid row or a whole grid,
+    /// and start a new one.
+    template <unsigned Side>
+    bool end_line();
+
+    void fail(unsigned line, const char* format, ...);
+
+    std::FILE* File_ = nullptr;
+    std::vector<char> Buffer_;
+
+    std::size_t Position_ = 0;
+    std::size_t Size_ = 0;
+
+    // Offset of the buffer and of the current line start in the file,
+    // used to compute the column of an invalid character.
+    std::size_t BufferOffset_ = 0;
+    std::size_t LineOffset_ = 0;
+    unsigned Line_ = 1;
+
+    // Number of cells on the current line, and index in its grid of the
+    // first one.
+    unsigned LineCells_ = 0;
+    unsigned LineStart_ = 0;
+
+    bool Failed_ = false;
+    unsigned ErrorLine_ = 0;
+    std::string ErrorMessage_;
+};
+
+/// @brief Append @p grid to @p out in a layout PuzzleReader reads back: on
+/// one line, or one grid row per line if @p spaced, then a line break.
+template <unsigned Side>
+void format_grid(const BasicSudokuGrid<Side>& grid, bool spaced, std::string& out);
+
+/// @brief Guess the side of the grids in a file from its first non-empty line.
+///
+/// A line with spaces between the cells is a grid row, otherwise the line
+/// is a whole grid. A packed corpus (see PackedCorpus) tells the side in its
+/// header.
+/// @return The grid side (4, 9, 16 or 25) or 0 if it can't be told.
+unsigned detect_grid_side(const char* filePath);
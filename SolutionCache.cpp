@@ -0,0 +1,83 @@
+#include "SolutionCache.h"
+
+#include <algorithm>
+
+SolutionCache::SolutionCache(std::size_t capacity)
+    : Capacity_(std::max<std::size_t>(capacity, 1))
+{ }
+
+std::size_t SolutionCache::capacity() const noexcept
+{
+    return this->Capacity_;
+}
+
+std::size_t SolutionCache::size() const
+{
+    const std::lock_guard<std::mutex> lock(this->Mutex_);
+    return this->Entries_.size();
+}
+
+unsigned long SolutionCache::hits() const
+{
+    const std::lock_guard<std::mutex> lock(this->Mutex_);
+    return this->Hits_;
+}
+
+unsigned long SolutionCache::misses() const
+{
+    const std::lock_guard<std::mutex> lock(this->Mutex_);
+    return this->Misses_;
+}
+
+bool SolutionCache::find(const SudokuGrid& canonical, SudokuGrid& solution)
+{
+    const auto hash = grid_hash(canonical);
+
+    const std::lock_guard<std::mutex> lock(this->Mutex_);
+    const auto found = this->Index_.find(hash);
+    if (found == this->Index_.end() || !std::equal(canonical.cbegin(), canonical.cend(), found->second->Puzzle.cbegin()))
+    {
+        ++(this->Misses_);
+        return false;
+    }
+
+    ++(this->Hits_);
+    this->Entries_.splice(this->Entries_.begin(), this->Entries_, found->second);
+    solution = found->second->Solution;
+    return true;
+}
+
+void SolutionCache::insert(const SudokuGrid& canonical, const SudokuGrid& solution)
+{
+    const auto hash = grid_hash(canonical);
+
+    const std::lock_guard<std::mutex> lock(this->Mutex_);
+    const auto found = this->Index_.find(hash);
+    if (found != this->Index_.end())
+    {
+        // The same puzzle, or a collision: the newest one wins.
+        auto& entry = *found->second;
+        entry.Puzzle = canonical;
+        entry.Solution = solution;
+        this->Entries_.splice(this->Entries_.begin(), this->Entries_, found->second);
+        return;
+    }
+
+    if (this->Entries_.size() == this->Capacity_)
+    {
+        this->Index_.erase(this->Entries_.back().Hash);
+        this->Entries_.pop_back();
+    }
+
+    this->Entries_.push_front(Entry { hash, canonical, solution });
+    this->Index_.emplace(hash, this->Entries_.begin());
+}
+
+void SolutionCache::clear()
+{
+    const std::lock_guard<std::mutex> lock(this->Mutex_);
+    this->Entries_.clear();
+    this->Index_.clear();
+    this->Hits_ = 0;
+    this->Misses_ = 0;
+}
@@ -0,0 +1,128 @@
+#pragma once
+
+#include "Canonicalizer.h"
+#include "Solver.h"
+#include "SudokuGrid.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+/// @brief A bounded cache from canonical puzzles to their canonical
+/// solution, which drops the least recently used ones when full.
+///
+/// Puzzles are looked up by grid_hash(), then compared in full, so that a
+/// hash collision is a miss and never a wrong solution. The cache can be
+/// shared between threads.
+class SolutionCache final
+{
+public:
+    explicit SolutionCache(std::size_t capacity);
+
+    std::size_t capacity() const noexcept;
+    std::size_t size() const;
+
+    unsigned long hits() const;
+    unsigned long misses() const;
+
+    /// @brief Look up the solution of @p canonical, and mark it as used.
+    /// @return false if it isn't in the cache.
+    bool find(const SudokuGrid& canonical, SudokuGrid& solution);
+
+    void insert(const SudokuGrid& canonical, const SudokuGrid& solution);
+
+    void clear();
+
+private:
+    struct Entry
+    {
+        std::uint64_t Hash;
+        SudokuGrid Puzzle;
+        SudokuGrid Solution;
+    };
+
+    std::size_t Capacity_ = 0;
+
+    mutable std::mutex Mutex_;
+
+    // The most recently used first.
+    std::list<Entry> Entries_;
+    std::unordered_map<std::uint64_t, std::list<Entry>::iterator> Index_;
+
+    unsigned long Hits_ = 0;
+    unsigned long Misses_ = 0;
+};
+
+/// @brief Solves a 9x9 grid with SolverType, unless an equivalent grid was
+/// solved before.
+///
+/// The grid is brought to its canonical form (see Canonicalizer), whose
+/// solution is looked up in the cache: a hit is mapped back to the grid by
+/// the inverse transform. Otherwise, the grid is solved and its solution is
+/// cached in canonical form, by a SolverType kept for the next misses.
+template <typename SolverType>
+class CachedSolver final : public Solver
+{
+public:
+    using grid_type = SudokuGrid;
+
+    /// @brief A solver to be reset() for each grid.
+    explicit CachedSolver(SolutionCache& cache)
+        : Cache_(&cache)
+    { }
+
+    CachedSolver(grid_type& grid, SolutionCache& cache)
+        :
+          Solver(grid),
+          Cache_(&cache)
+    { }
+
+    void reset(grid_type& grid) override
+    {
+        Solver::reset(grid);
+        this->CacheHit_ = false;
+    }
+
+    bool exec() override
+    {
+        // Kept from one grid to the next, so that its buffers are only
+        // allocated once per thread.
+        static thread_local Canonicalizer canonicalizer;
+
+        SudokuGrid canonical;
+        const auto transform = canonicalizer.canonicalize(*this->Grid_, canonical);
+
+        SudokuGrid solution;
+        this->CacheHit_ = this->Cache_->find(canonical, solution);
+        if (this->CacheHit_)
+        {
+            transform.apply_inverse(solution, *this->Grid_);
+            this->InsertedDigits_ = this->NumberOfMissingDigits_;
+            return true;
+        }
+
+        this->Solver_.reset(*this->Grid_);
+        const auto solved = this->Solver_.exec();
+        this->InsertedDigits_ = this->Solver_.insertedDigits();
+        if (solved)
+        {
+            transform.apply(*this->Grid_, solution);
+            this->Cache_->insert(canonical, solution);
+        }
+
+        return solved;
+    }
+
+    /// @brief Whether exec() found the solution in the cache.
+    bool cacheHit() const noexcept
+    {
+        return this->CacheHit_;
+    }
+
+private:
+    SolutionCache* Cache_ = nullptr;
+    SolverType Solver_;
+    bool CacheHit_ = false;
+};
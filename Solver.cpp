@@ -6,26 +6,51 @@
 
 namespace
 {
-    unsigned count_empty_cells(const SudokuGrid& grid) noexcept
+    template <unsigned Side>
+    unsigned count_empty_cells(const BasicSudokuGrid<Side>& grid) noexcept
     {
         const auto first = std::cbegin(grid);
         const auto last = std::cend(grid);
-        return std::count_if(first, last, [](const SudokuGrid::value_type c) { return is_empty(c); });
+        return std::count_if(first, last, [](const char c) { return is_empty(c); });
     }
 }
 
-Solver::Solver(SudokuGrid& grid)
+template <unsigned Side>
+BasicSolver<Side>::BasicSolver(grid_type& grid)
     :
       Grid_(std::addressof(grid)),
       NumberOfMissingDigits_(count_empty_cells(grid))
 { }
 
-unsigned Solver::insertedDigits() const
+template <unsigned Side>
+void BasicSolver<Side>::reset(grid_type& grid)
+{
+    this->Grid_ = std::addressof(grid);
+    this->InsertedDigits_ = 0;
+    this->NumberOfMissingDigits_ = count_empty_cells(grid);
+}
+
+template <unsigned Side>
+bool BasicSolver<Side>::solve(const grid_type& puzzle, grid_type& solution)
+{
+    solution = puzzle;
+    this->reset(solution);
+    return this->exec();
+}
+
+template <unsigned Side>
+unsigned BasicSolver<Side>::insertedDigits() const
 {
     return this->InsertedDigits_;
 }
 
-unsigned Solver::originalNumberOfMissingDigits() const
+template <unsigned Side>
+unsigned BasicSolver<Side>::originalNumberOfMissingDigits() const
 {
     return this->NumberOfMissingDigits_;
 }
+
+template class BasicSolver<4>;
+template class BasicSolver<9>;
+template class BasicSolver<16>;
+template class BasicSolver<25>;
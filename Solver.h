@@ -2,27 +2,51 @@
 
 #include "SudokuGrid.h"
 
-class Solver
+/// @brief Solves a grid in place.
+///
+/// A solver is either built for a grid, or built once and then pointed at
+/// one grid after the other with reset() or solve(): the buffers of the
+/// derived solvers are kept from one grid to the next, so that a long-lived
+/// solver (e.g. one per worker thread) costs next to nothing per grid.
+/// Solvers can be moved, but not copied.
+template <unsigned Side>
+class BasicSolver
 {
 public:
-    explicit Solver(SudokuGrid& grid);
+    using grid_type = BasicSudokuGrid<Side>;
 
-    Solver(const Solver&) = delete;
-    Solver(Solver&&) = delete;
+    BasicSolver(const BasicSolver&) = delete;
+    BasicSolver& operator=(const BasicSolver&) = delete;
 
-    Solver& operator=(const Solver&) = delete;
-    Solver& operator=(Solver&&) = delete;
+    virtual ~BasicSolver() = default;
 
-    virtual ~Solver() = default;
+    /// @brief Solve @p grid in place on the next exec(), forgetting the
+    /// previous grid.
+    virtual void reset(grid_type& grid);
 
+    /// @pre A grid was given to the constructor or to reset().
     virtual bool exec() = 0;
 
+    /// @brief Copy @p puzzle to @p solution, and solve it there.
+    bool solve(const grid_type& puzzle, grid_type& solution);
+
     unsigned insertedDigits() const;
     unsigned originalNumberOfMissingDigits() const;
 
 protected:
-    SudokuGrid* const Grid_ = nullptr;
+    /// @brief A solver without a grid yet.
+    BasicSolver() noexcept = default;
+
+    explicit BasicSolver(grid_type& grid);
+
+    // Only the derived solvers move, as a whole.
+    BasicSolver(BasicSolver&&) noexcept = default;
+    BasicSolver& operator=(BasicSolver&&) noexcept = default;
+
+    grid_type* Grid_ = nullptr;
 
     unsigned InsertedDigits_ = 0;
-    const unsigned NumberOfMissingDigits_ = 0;
+    unsigned NumberOfMissingDigits_ = 0;
 };
+
+using Solver = BasicSolver<9>;
@@ -42,10 +42,23 @@ public:
 
     void push_back(T v)
     {
+        assert(this->size() < capacity());
         this->Data_[this->Size_] = v;
         ++this->Size_;
     }
 
+    const T& back() const
+    {
+        assert(!this->empty());
+        return this->Data_[this->Size_ - 1];
+    }
+
+    void pop_back()
+    {
+        assert(!this->empty());
+        --this->Size_;
+    }
+
     using iterator = typename std::array<T, Capacity>::iterator;
     using const_iterator = typename std::array<T, Capacity>::const_iterator;
     using value_type = T;
@@ -1,62 +1,69 @@
 #include "SudokuGrid.h"
 
-#include "constexpr_functions.h"
+#include "PuzzleReader.h"
 
 #include <cassert>
 #include <cstdio>
-#include <fstream>
 
-bool fill_from_input_file(const char* filePath, SudokuGrid& grid)
+template <unsigned Side>
+bool fill_from_input_file(const char* filePath, BasicSudokuGrid<Side>& grid)
 {
-    std::ifstream inFile (filePath);
-    if (!inFile.is_open())
+    PuzzleReader reader(filePath);
+    if (reader.read(grid))
+        return true;
+
+    if (reader.failed())
     {
-        fprintf(stderr, "Invalid input file '%s'\n", filePath);
-        return false;
+        fprintf(stderr, "%s\n", reader.errorMessage().c_str());
     }
-
-    for (size_t r = 0; r < SudokuGrid::sideLength(); ++r)
+    else
     {
-        for (size_t c = 0; c < SudokuGrid::sideLength(); ++c)
-        {
-            char buffer = 0;
-            inFile >> buffer;
-
-            if (buffer < '0' || buffer > '9')
-            {
-                fprintf(stderr, "Invalid input: '%c' at (%zu, %zu)\n", buffer, r, c);
-                return false;
-            }
-
-            //grid[r][c] = static_cast<char>(buffer - '0');
-            //grid[r][c] = buffer - 48;
-            grid[r][c] = buffer - '0';
-        }
+        fprintf(stderr, "No grid in input file '%s'\n", filePath);
     }
 
-    return true;
+    return false;
 }
 
 namespace
 {
 
-void print_row(const SudokuGrid& grid, size_t row)
+template <unsigned Side>
+constexpr unsigned row_length() noexcept
 {
-    assert(row < SudokuGrid::rows());
-    printf("%c  %c  %c | %c  %c  %c | %c  %c  %c\n",
-            grid[row][0] + '0', // NOLINT(cppcoreguidelines-avoid-magic-numbers)
-            grid[row][1] + '0', // NOLINT(cppcoreguidelines-avoid-magic-numbers)
-            grid[row][2] + '0', // NOLINT(cppcoreguidelines-avoid-magic-numbers)
-            grid[row][3] + '0', // NOLINT(cppcoreguidelines-avoid-magic-numbers)
-            grid[row][4] + '0', // NOLINT(cppcoreguidelines-avoid-magic-numbers)
-            grid[row][5] + '0', // NOLINT(cppcoreguidelines-avoid-magic-numbers)
-            grid[row][6] + '0', // NOLINT(cppcoreguidelines-avoid-magic-numbers)
-            grid[row][7] + '0', // NOLINT(cppcoreguidelines-avoid-magic-numbers)
-            grid[row][8] + '0'); // NOLINT(cppcoreguidelines-avoid-magic-numbers)
+    constexpr auto subgridSideLength = BasicSudokuGrid<Side>::subgridSideLength();
 
+    // One character per cell, two spaces between cells in the same
+    // subgrid and " | " between subgrids.
+    return Side + 2 * (Side - subgridSideLength) + 3 * (subgridSideLength - 1);
 }
 
-void print_rows(const SudokuGrid& grid, size_t rowStart, size_t rowEnd)
+template <unsigned Side>
+void print_row(const BasicSudokuGrid<Side>& grid, size_t row)
+{
+    assert(row < BasicSudokuGrid<Side>::rows());
+    constexpr auto subgridSideLength = BasicSudokuGrid<Side>::subgridSideLength();
+
+    char line[row_length<Side>() + 1] = {};
+    auto* out = line;
+    for (size_t c = 0; c < Side; ++c)
+    {
+        if (0 != c)
+        {
+            const auto* separator = 0 == c % subgridSideLength ? " | " : "  ";
+            while ('\0' != *separator)
+            {
+                *out++ = *separator++;
+            }
+        }
+
+        *out++ = to_symbol(grid[row][c]);
+    }
+
+    puts(line);
+}
+
+template <unsigned Side>
+void print_rows(const BasicSudokuGrid<Side>& grid, size_t rowStart, size_t rowEnd)
 {
     for (size_t r = rowStart; r < rowEnd; ++r)
     {
@@ -64,23 +71,31 @@ void print_rows(const SudokuGrid& grid, size_t rowStart, size_t rowEnd)
     }
 }
 
+template <unsigned Side>
 void print_row_separator()
 {
-    puts("---------------------------");
+    char line[row_length<Side>() + 1] = {};
+    for (unsigned i = 0; i < row_length<Side>(); ++i)
+    {
+        line[i] = '-';
+    }
+
+    puts(line);
 }
 
 }
 
-void print_grid(const SudokuGrid& grid)
+template <unsigned Side>
+void print_grid(const BasicSudokuGrid<Side>& grid)
 {
-    constexpr auto subgridSideLength = Sqrt<SudokuGrid::sideLength()>::value;
+    constexpr auto subgridSideLength = BasicSudokuGrid<Side>::subgridSideLength();
 
     auto rStart = 0;
     auto rEnd =  subgridSideLength;
     for (size_t sgr = 0; sgr < subgridSideLength - 1; ++sgr)
     {
         print_rows(grid, rStart, rEnd);
-        print_row_separator();
+        print_row_separator<Side>();
 
         rStart += subgridSideLength;
         rEnd += subgridSideLength;
@@ -88,3 +103,13 @@ void print_grid(const SudokuGrid& grid)
 
     print_rows(grid, rStart, rEnd);
 }
+
+template bool fill_from_input_file(const char*, BasicSudokuGrid<4>&);
+template bool fill_from_input_file(const char*, BasicSudokuGrid<9>&);
+template bool fill_from_input_file(const char*, BasicSudokuGrid<16>&);
+template bool fill_from_input_file(const char*, BasicSudokuGrid<25>&);
+
+template void print_grid(const BasicSudokuGrid<4>&);
+template void print_grid(const BasicSudokuGrid<9>&);
+template void print_grid(const BasicSudokuGrid<16>&);
+template void print_grid(const BasicSudokuGrid<25>&);
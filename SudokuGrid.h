@@ -3,23 +3,58 @@
 #include "Matrix.h" // IWYU pragma: export
 #include "constexpr_functions.h"
 
+#include "fwd/SudokuGrid.h" // IWYU pragma: export
+
 static constexpr unsigned SudokuGridSide = 9;
 static constexpr unsigned SudokuSubgridSide = Sqrt<SudokuGridSide>::value;
 
-class SudokuGrid final : public Matrix<char, SudokuGridSide, SudokuGridSide>
+/// @brief A Side x Side grid made of Side subgrids.
+///
+/// Side must be the square of the subgrid side: the library is instantiated
+/// for 4x4, 9x9, 16x16 and 25x25 grids.
+template <unsigned Side>
+class BasicSudokuGrid final : public Matrix<char, Side, Side>
 {
 public:
     static constexpr unsigned sideLength() noexcept
     {
-        static_assert (rows() == columns(), "Grid is not square" );
-        return rows();
+        static_assert (BasicSudokuGrid::rows() == BasicSudokuGrid::columns(), "Grid is not square" );
+        return Side;
+    }
+
+    static constexpr unsigned subgridSideLength() noexcept
+    {
+        static_assert (Square<Sqrt<Side>::value>::value == Side, "Grid side is not a square");
+        return Sqrt<Side>::value;
     }
 };
 
-constexpr bool is_empty(typename SudokuGrid::value_type cell) noexcept
+constexpr bool is_empty(char cell) noexcept
 {
     return 0 == cell;
 }
 
-bool fill_from_input_file(const char* filePath, SudokuGrid& grid);
-void print_grid(const SudokuGrid& grid);
+/// @brief The character representing @p cell in text files.
+///
+/// Digits 1 to 9 are written as such, larger ones as letters from 'A' on
+/// (e.g. 'A' to 'G' for 10 to 16). Empty cells are written as '0'.
+constexpr char to_symbol(char cell) noexcept
+{
+    return cell < 10 ? static_cast<char>('0' + cell) : static_cast<char>('A' + cell - 10);
+}
+
+/// @brief The cell value of @p symbol (see to_symbol()), or -1 if
+/// @p symbol is not a cell. '.' is an empty cell too.
+constexpr int from_symbol(char symbol) noexcept
+{
+    return ('0' <= symbol && symbol <= '9') ? symbol - '0' :
+           ('A' <= symbol && symbol <= 'Z') ? symbol - 'A' + 10 :
+           ('a' <= symbol && symbol <= 'z') ? symbol - 'a' + 10 :
+           ('.' == symbol) ? 0 : -1;
+}
+
+template <unsigned Side>
+bool fill_from_input_file(const char* filePath, BasicSudokuGrid<Side>& grid);
+
+template <unsigned Side>
+void print_grid(const BasicSudokuGrid<Side>& grid);
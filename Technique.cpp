@@ -0,0 +1,72 @@
+#include "Technique.h"
+
+#include <cstring>
+
+namespace
+{
+
+const char* const TechniqueNames[TechniqueCount] = {
+    "naked-single",
+    "hidden-single",
+    "pointing",
+    "claiming",
+    "naked-pair",
+    "x-wing",
+    "hidden-pair",
+    "naked-triple",
+    "swordfish",
+    "hidden-triple",
+    "naked-quad",
+    "jellyfish",
+    "hidden-quad"
+};
+
+bool find_technique(const char* name, std::size_t length, Technique& technique)
+{
+    for (unsigned i = 0; i < TechniqueCount; ++i)
+    {
+        if (length == std::strlen(TechniqueNames[i]) && 0 == std::strncmp(name, TechniqueNames[i], length))
+        {
+            technique = static_cast<Technique>(i);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+}
+
+const char* technique_name(Technique technique) noexcept
+{
+    return TechniqueNames[static_cast<unsigned>(technique)];
+}
+
+bool TechniqueSet::parse(const char* list, TechniqueSet& techniques)
+{
+    if (0 == std::strcmp(list, "all"))
+    {
+        techniques = all();
+        return true;
+    }
+
+    TechniqueSet parsed;
+    for (;;)
+    {
+        const auto* const end = std::strchr(list, ',');
+        const auto length = nullptr == end ? std::strlen(list) : static_cast<std::size_t>(end - list);
+
+        Technique technique = Technique::NakedSingle;
+        if (!find_technique(list, length, technique))
+            return false;
+
+        parsed.insert(technique);
+        if (nullptr == end)
+            break;
+
+        list = end + 1;
+    }
+
+    techniques = parsed;
+    return true;
+}
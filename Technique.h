@@ -0,0 +1,105 @@
+#pragma once
+
+#include <cstdint>
+
+/// @brief The solving techniques, from the cheapest to the most expensive.
+enum class Technique : unsigned
+{
+    NakedSingle,
+    HiddenSingle,
+    Pointing,
+    Claiming,
+    NakedPair,
+    XWing,
+    HiddenPair,
+    NakedTriple,
+    Swordfish,
+    HiddenTriple,
+    NakedQuad,
+    Jellyfish,
+    HiddenQuad
+};
+
+static constexpr unsigned TechniqueCount = static_cast<unsigned>(Technique::HiddenQuad) + 1;
+
+/// @brief The name of @p technique, as accepted by TechniqueSet::parse().
+const char* technique_name(Technique technique) noexcept;
+
+/// @brief A set of techniques, e.g. those a solver is allowed to use.
+class TechniqueSet final
+{
+public:
+    constexpr TechniqueSet() noexcept = default;
+
+    static constexpr TechniqueSet all() noexcept
+    {
+        return TechniqueSet((std::uint32_t(1) << TechniqueCount) - 1);
+    }
+
+    /// @brief The techniques up to @p last included, in order of cost.
+    static constexpr TechniqueSet up_to(Technique last) noexcept
+    {
+        return TechniqueSet((std::uint32_t(1) << (static_cast<unsigned>(last) + 1)) - 1);
+    }
+
+    constexpr bool contains(Technique technique) const noexcept
+    {
+        return 0 != (this->Bits_ & bit(technique));
+    }
+
+    constexpr bool empty() const noexcept
+    {
+        return 0 == this->Bits_;
+    }
+
+    void insert(Technique technique) noexcept
+    {
+        this->Bits_ |= bit(technique);
+    }
+
+    void erase(Technique technique) noexcept
+    {
+        this->Bits_ &= ~bit(technique);
+    }
+
+    /// @brief Parse a comma separated list of technique names, or "all".
+    /// @return false on an unknown name; @p techniques is left unchanged.
+    static bool parse(const char* list, TechniqueSet& techniques);
+
+    friend constexpr bool operator==(TechniqueSet lhs, TechniqueSet rhs) noexcept
+    {
+        return lhs.Bits_ == rhs.Bits_;
+    }
+
+    friend constexpr bool operator!=(TechniqueSet lhs, TechniqueSet rhs) noexcept
+    {
+        return !(lhs == rhs);
+    }
+
+private:
+    constexpr explicit TechniqueSet(std::uint32_t bits) noexcept
+        : Bits_(bits)
+    { }
+
+    static constexpr std::uint32_t bit(Technique technique) noexcept
+    {
+        return std::uint32_t(1) << static_cast<unsigned>(technique);
+    }
+
+    std::uint32_t Bits_ = 0;
+};
+
+/// @brief What a technique did while solving a grid.
+struct TechniqueStats
+{
+    /// Number of times the technique looked for a deduction.
+    unsigned long Attempts = 0;
+
+    /// Number of deductions it found.
+    unsigned long Steps = 0;
+
+    unsigned long Placements = 0;
+
+    /// Number of candidates its deductions removed.
+    unsigned long Eliminations = 0;
+};
@@ -0,0 +1,730 @@
+#include "TechniquePipeline.h"
+
+#include <cassert>
+
+namespace
+{
+
+/// @brief Record that @p digits go from @p cell, if it has any of them.
+template <unsigned Side>
+void add_elimination(const BasicCandidateBoard<Side>& board, unsigned cell, BasicDigitMask<Side> digits, BasicDeduction<Side>& deduction)
+{
+    const auto removed = board.candidates(cell) & digits;
+    if (!removed.empty())
+    {
+        deduction.Eliminations.push_back(typename BasicDeduction<Side>::Elimination { static_cast<std::uint16_t>(cell), removed });
+    }
+}
+
+/// @brief Look for @p size masks among masks[first, count) which hold no
+/// more than @p size elements between them (and @p united), and call
+/// @p found with their union until it returns true. The indices of the
+/// masks are in chosen[0, size).
+template <typename Mask, typename Found>
+bool find_locked_set(const Mask* masks, unsigned count, unsigned size, unsigned first, unsigned depth, Mask united, unsigned* chosen, Found& found)
+{
+    if (depth == size)
+        return united.count() == size && found(united);
+
+    for (auto i = first; i + size - depth <= count; ++i)
+    {
+        const auto next = united | masks[i];
+        if (next.count() > size)
+            continue;
+
+        chosen[depth] = i;
+        if (find_locked_set(masks, count, size, i + 1, depth + 1, next, chosen, found))
+            return true;
+    }
+
+    return false;
+}
+
+/// @brief The positions first + 1, first + 1 + stride, ... of @p count
+/// cells of a unit: e.g. a row or a column of a subgrid.
+template <unsigned Side>
+BasicDigitMask<Side> position_range(unsigned first, unsigned count, unsigned stride) noexcept
+{
+    BasicDigitMask<Side> positions;
+    for (unsigned i = 0; i < count; ++i)
+    {
+        positions.insert(first + 1 + i * stride);
+    }
+
+    return positions;
+}
+
+unsigned subset_size(Technique kind) noexcept
+{
+    switch (kind)
+    {
+    case Technique::NakedPair:
+    case Technique::XWing:
+    case Technique::HiddenPair:
+        return 2;
+    case Technique::NakedTriple:
+    case Technique::Swordfish:
+    case Technique::HiddenTriple:
+        return 3;
+    case Technique::NakedQuad:
+    case Technique::Jellyfish:
+    case Technique::HiddenQuad:
+        return 4;
+    default:
+        assert(false && "Not a subset or fish technique");
+        return 2;
+    }
+}
+
+}
+
+template <unsigned Side>
+BasicTechniqueStrategy<Side>::BasicTechniqueStrategy(Technique kind) noexcept
+    : Kind_(kind)
+{ }
+
+template <unsigned Side>
+Technique BasicTechniqueStrategy<Side>::kind() const noexcept
+{
+    return this->Kind_;
+}
+
+template <unsigned Side>
+const TechniqueStats& BasicTechniqueStrategy<Side>::stats() const noexcept
+{
+    return this->Stats_;
+}
+
+template <unsigned Side>
+bool BasicTechniqueStrategy<Side>::find(const board_type& board, deduction_type& deduction)
+{
+    ++(this->Stats_.Attempts);
+
+    deduction.clear();
+    deduction.Kind = this->Kind_;
+    if (!this->search(board, deduction))
+        return false;
+
+    ++(this->Stats_.Steps);
+    if (deduction.placement())
+    {
+        ++(this->Stats_.Placements);
+    }
+
+    for (const auto& elimination : deduction.Eliminations)
+    {
+        this->Stats_.Eliminations += elimination.Digits.count();
+    }
+
+    return true;
+}
+
+template <unsigned Side>
+void BasicTechniqueStrategy<Side>::reset() noexcept
+{ }
+
+template <unsigned Side>
+BasicUnitTechnique<Side>::BasicUnitTechnique(Technique kind, unsigned firstUnit, unsigned lastUnit) noexcept
+    :
+      BasicTechniqueStrategy<Side>(kind),
+      FirstUnit_(firstUnit),
+      LastUnit_(lastUnit)
+{ }
+
+template <unsigned Side>
+void BasicUnitTechnique<Side>::reset() noexcept
+{
+    for (auto& version : this->CheckedVersions_)
+    {
+        version = 0;
+    }
+}
+
+template <unsigned Side>
+bool BasicUnitTechnique<Side>::search(const board_type& board, deduction_type& deduction)
+{
+    for (auto unit = this->FirstUnit_; unit < this->LastUnit_; ++unit)
+    {
+        const auto version = board.unitVersion(unit);
+        if (version == this->CheckedVersions_[unit])
+            continue;
+
+        if (this->find_in_unit(board, unit, deduction))
+            return true;
+
+        this->CheckedVersions_[unit] = version;
+    }
+
+    return false;
+}
+
+template <unsigned Side>
+BasicNakedSingle<Side>::BasicNakedSingle() noexcept
+    : BasicTechniqueStrategy<Side>(Technique::NakedSingle)
+{ }
+
+template <unsigned Side>
+bool BasicNakedSingle<Side>::search(const board_type& board, deduction_type& deduction)
+{
+    unsigned cell = 0;
+    if (!board.find_single(cell))
+        return false;
+
+    deduction.Unit = board_type::row_unit(cell);
+    deduction.Cells.push_back(static_cast<std::uint16_t>(cell));
+    deduction.Digits = board.candidates(cell);
+    return true;
+}
+
+template <unsigned Side>
+BasicHiddenSingle<Side>::BasicHiddenSingle() noexcept
+    : BasicUnitTechnique<Side>(Technique::HiddenSingle, 0, board_type::UnitCount)
+{ }
+
+template <unsigned Side>
+bool BasicHiddenSingle<Side>::find_in_unit(const board_type& board, unsigned unit, deduction_type& deduction) const
+{
+    using candidate_mask = typename board_type::candidate_mask;
+
+    // Each digit is either placed or a candidate somewhere in the unit.
+    candidate_mask missing;
+    unsigned single = 0;
+    for (auto remaining = and_not(candidate_mask::all(), board.placedDigits(unit)); !remaining.empty(); )
+    {
+        const auto digit = remaining.pop_lowest();
+        const auto positions = board.positions(digit, unit);
+        if (positions.empty())
+        {
+            missing.insert(digit);
+        }
+        else if (0 == single && 1 == positions.count())
+        {
+            single = digit;
+        }
+    }
+
+    deduction.Unit = unit;
+    if (!missing.empty())
+    {
+        deduction.Contradiction = true;
+        deduction.Digits = missing;
+        return true;
+    }
+
+    if (0 == single)
+        return false;
+
+    deduction.Cells.push_back(static_cast<std::uint16_t>(board_type::unit_cell(unit, board.positions(single, unit).lowest() - 1)));
+    deduction.Digits = candidate_mask::single(single);
+    return true;
+}
+
+template <unsigned Side>
+BasicPointing<Side>::BasicPointing() noexcept
+    : BasicUnitTechnique<Side>(Technique::Pointing, 2 * Side, board_type::UnitCount)
+{ }
+
+template <unsigned Side>
+bool BasicPointing<Side>::find_in_unit(const board_type& board, unsigned unit, deduction_type& deduction) const
+{
+    using candidate_mask = typename board_type::candidate_mask;
+    constexpr auto subgridSide = board_type::grid_type::subgridSideLength();
+
+    const auto subgrid = unit - 2 * Side;
+    const auto rowStart = subgridSide * (subgrid / subgridSide);
+    const auto columnStart = subgridSide * (subgrid % subgridSide);
+
+    // The columns of the subgrid along a row, and its rows along a column.
+    const auto subgridColumns = position_range<Side>(columnStart, subgridSide, 1);
+    const auto subgridRows = position_range<Side>(rowStart, subgridSide, 1);
+
+    const auto record = [&](unsigned digit, unsigned line, candidate_mask outside)
+    {
+        while (!outside.empty())
+        {
+            const auto cell = board_type::unit_cell(line, outside.pop_lowest() - 1);
+            deduction.Eliminations.push_back(typename deduction_type::Elimination { static_cast<std::uint16_t>(cell), candidate_mask::single(digit) });
+        }
+
+        for (auto positions = board.positions(digit, unit); !positions.empty(); )
+        {
+            deduction.Cells.push_back(static_cast<std::uint16_t>(board_type::unit_cell(unit, positions.pop_lowest() - 1)));
+        }
+
+        deduction.Unit = unit;
+        deduction.Digits = candidate_mask::single(digit);
+        return true;
+    };
+
+    for (auto remaining = and_not(candidate_mask::all(), board.placedDigits(unit)); !remaining.empty(); )
+    {
+        const auto digit = remaining.pop_lowest();
+        const auto positions = board.positions(digit, unit);
+        if (positions.empty())
+            continue;
+
+        // The digit only fits in one row of the subgrid.
+        const auto row = (positions.lowest() - 1) / subgridSide;
+        if (positions.is_subset_of(position_range<Side>(row * subgridSide, subgridSide, 1)))
+        {
+            const auto outside = and_not(board.positions(digit, rowStart + row), subgridColumns);
+            if (!outside.empty())
+                return record(digit, rowStart + row, outside);
+        }
+
+        // Or in one column.
+        const auto column = (positions.lowest() - 1) % subgridSide;
+        if (positions.is_subset_of(position_range<Side>(column, subgridSide, subgridSide)))
+        {
+            const auto outside = and_not(board.positions(digit, Side + columnStart + column), subgridRows);
+            if (!outside.empty())
+                return record(digit, Side + columnStart + column, outside);
+        }
+    }
+
+    return false;
+}
+
+template <unsigned Side>
+BasicClaiming<Side>::BasicClaiming() noexcept
+    // Rows and columns.
+    : BasicUnitTechnique<Side>(Technique::Claiming, 0, 2 * Side)
+{ }
+
+template <unsigned Side>
+bool BasicClaiming<Side>::find_in_unit(const board_type& board, unsigned unit, deduction_type& deduction) const
+{
+    using candidate_mask = typename board_type::candidate_mask;
+    constexpr auto subgridSide = board_type::grid_type::subgridSideLength();
+
+    // Where the line crosses the subgrids, as positions in those subgrids.
+    const auto lineIndex = unit < Side ? unit : unit - Side;
+    const auto crossing = unit < Side
+        ? position_range<Side>(subgridSide * (lineIndex % subgridSide), subgridSide, 1)
+        : position_range<Side>(lineIndex % subgridSide, subgridSide, subgridSide);
+
+    for (auto remaining = and_not(candidate_mask::all(), board.placedDigits(unit)); !remaining.empty(); )
+    {
+        const auto digit = remaining.pop_lowest();
+        const auto positions = board.positions(digit, unit);
+        if (positions.empty())
+            continue;
+
+        // The digit only fits where the line crosses the k-th subgrid.
+        const auto k = (positions.lowest() - 1) / subgridSide;
+        if (!positions.is_subset_of(position_range<Side>(k * subgridSide, subgridSide, 1)))
+            continue;
+
+        const auto subgrid = board_type::subgrid_unit(board_type::unit_cell(unit, k * subgridSide));
+        auto outside = and_not(board.positions(digit, subgrid), crossing);
+        if (outside.empty())
+            continue;
+
+        while (!outside.empty())
+        {
+            const auto cell = board_type::unit_cell(subgrid, outside.pop_lowest() - 1);
+            deduction.Eliminations.push_back(typename deduction_type::Elimination { static_cast<std::uint16_t>(cell), candidate_mask::single(digit) });
+        }
+
+        for (auto cells = positions; !cells.empty(); )
+        {
+            deduction.Cells.push_back(static_cast<std::uint16_t>(board_type::unit_cell(unit, cells.pop_lowest() - 1)));
+        }
+
+        deduction.Unit = unit;
+        deduction.Digits = candidate_mask::single(digit);
+        return true;
+    }
+
+    return false;
+}
+
+template <unsigned Side>
+BasicNakedSubset<Side>::BasicNakedSubset(Technique kind) noexcept
+    :
+      BasicUnitTechnique<Side>(kind, 0, board_type::UnitCount),
+      Size_(subset_size(kind))
+{ }
+
+template <unsigned Side>
+bool BasicNakedSubset<Side>::find_in_unit(const board_type& board, unsigned unit, deduction_type& deduction) const
+{
+    using candidate_mask = typename board_type::candidate_mask;
+
+    // The unsolved cells with few enough candidates to be in the subset.
+    candidate_mask masks[Side];
+    unsigned cells[Side] = {};
+    unsigned count = 0;
+    unsigned unsolved = 0;
+    for (unsigned i = 0; i < Side; ++i)
+    {
+        const auto cell = board_type::unit_cell(unit, i);
+        const auto candidates = board.candidates(cell);
+        if (candidates.empty())
+            continue;
+
+        ++unsolved;
+        if (candidates.count() <= this->Size_)
+        {
+            masks[count] = candidates;
+            cells[count] = cell;
+            ++count;
+        }
+    }
+
+    // The subset must leave some cells to eliminate from.
+    if (unsolved <= this->Size_ || count < this->Size_)
+        return false;
+
+    unsigned chosen[4] = {};
+    const auto in_subset = [&](unsigned cell)
+    {
+        for (unsigned j = 0; j < this->Size_; ++j)
+        {
+            if (cells[chosen[j]] == cell)
+                return true;
+        }
+
+        return false;
+    };
+
+    auto found = [&](candidate_mask digits)
+    {
+        for (unsigned i = 0; i < Side; ++i)
+        {
+            const auto cell = board_type::unit_cell(unit, i);
+            if (!in_subset(cell))
+            {
+                add_elimination(board, cell, digits, deduction);
+            }
+        }
+
+        if (deduction.Eliminations.empty())
+            return false;
+
+        for (unsigned j = 0; j < this->Size_; ++j)
+        {
+            deduction.Cells.push_back(static_cast<std::uint16_t>(cells[chosen[j]]));
+        }
+
+        deduction.Unit = unit;
+        deduction.Digits = digits;
+        return true;
+    };
+
+    return find_locked_set(masks, count, this->Size_, 0, 0, candidate_mask(), chosen, found);
+}
+
+template <unsigned Side>
+BasicHiddenSubset<Side>::BasicHiddenSubset(Technique kind) noexcept
+    :
+      BasicUnitTechnique<Side>(kind, 0, board_type::UnitCount),
+      Size_(subset_size(kind))
+{ }
+
+template <unsigned Side>
+bool BasicHiddenSubset<Side>::find_in_unit(const board_type& board, unsigned unit, deduction_type& deduction) const
+{
+    using candidate_mask = typename board_type::candidate_mask;
+
+    // The digits with few enough positions to be in the subset.
+    const auto placed = board.placedDigits(unit);
+    candidate_mask masks[Side];
+    unsigned digits[Side] = {};
+    unsigned count = 0;
+    for (auto remaining = and_not(candidate_mask::all(), placed); !remaining.empty(); )
+    {
+        const auto digit = remaining.pop_lowest();
+        const auto positions = board.positions(digit, unit);
+        const auto fits = positions.count();
+        if (0 != fits && fits <= this->Size_)
+        {
+            masks[count] = positions;
+            digits[count] = digit;
+            ++count;
+        }
+    }
+
+    // The subset must leave some digits to eliminate.
+    if (Side - placed.count() <= this->Size_ || count < this->Size_)
+        return false;
+
+    unsigned chosen[4] = {};
+    auto found = [&](candidate_mask cellPositions)
+    {
+        candidate_mask subsetDigits;
+        for (unsigned j = 0; j < this->Size_; ++j)
+        {
+            subsetDigits.insert(digits[chosen[j]]);
+        }
+
+        const auto otherDigits = and_not(candidate_mask::all(), subsetDigits);
+        for (auto remaining = cellPositions; !remaining.empty(); )
+        {
+            add_elimination(board, board_type::unit_cell(unit, remaining.pop_lowest() - 1), otherDigits, deduction);
+        }
+
+        if (deduction.Eliminations.empty())
+            return false;
+
+        for (auto remaining = cellPositions; !remaining.empty(); )
+        {
+            deduction.Cells.push_back(static_cast<std::uint16_t>(board_type::unit_cell(unit, remaining.pop_lowest() - 1)));
+        }
+
+        deduction.Unit = unit;
+        deduction.Digits = subsetDigits;
+        return true;
+    };
+
+    return find_locked_set(masks, count, this->Size_, 0, 0, candidate_mask(), chosen, found);
+}
+
+template <unsigned Side>
+BasicFish<Side>::BasicFish(Technique kind) noexcept
+    :
+      BasicTechniqueStrategy<Side>(kind),
+      Size_(subset_size(kind))
+{
+    this->reset();
+}
+
+template <unsigned Side>
+void BasicFish<Side>::reset() noexcept
+{
+    this->CheckedVersion_ = 0;
+    for (auto& rows : this->CheckedRows_)
+    {
+        for (auto& positions : rows)
+        {
+            // A digit which fits everywhere makes no fish.
+            positions = candidate_mask::all();
+        }
+    }
+}
+
+template <unsigned Side>
+bool BasicFish<Side>::search(const board_type& board, deduction_type& deduction)
+{
+    const auto version = board.version();
+    if (version == this->CheckedVersion_)
+        return false;
+
+    for (unsigned digit = 1; digit <= Side; ++digit)
+    {
+        // Rows are units [0, Side) of the board.
+        auto& checkedRows = this->CheckedRows_[digit - 1];
+        bool changed = false;
+        for (unsigned row = 0; row < Side && !changed; ++row)
+        {
+            changed = board.positions(digit, row) != checkedRows[row];
+        }
+
+        if (!changed)
+            continue;
+
+        if (this->find_in_lines(board, digit, true, deduction) ||
+            this->find_in_lines(board, digit, false, deduction))
+            return true;
+
+        for (unsigned row = 0; row < Side; ++row)
+        {
+            checkedRows[row] = board.positions(digit, row);
+        }
+    }
+
+    this->CheckedVersion_ = version;
+    return false;
+}
+
+template <unsigned Side>
+bool BasicFish<Side>::find_in_lines(const board_type& board, unsigned digit, bool rows, deduction_type& deduction) const
+{
+    const auto firstUnit = rows ? 0 : Side;
+
+    // The base lines: those where the digit has few enough positions.
+    candidate_mask masks[Side];
+    unsigned baseLines[Side] = {};
+    unsigned count = 0;
+    for (unsigned line = 0; line < Side; ++line)
+    {
+        const auto positions = board.positions(digit, firstUnit + line);
+        const auto fits = positions.count();
+        if (0 != fits && fits <= this->Size_)
+        {
+            masks[count] = positions;
+            baseLines[count] = line;
+            ++count;
+        }
+    }
+
+    if (count < this->Size_)
+        return false;
+
+    unsigned chosen[4] = {};
+    auto found = [&](candidate_mask coverLines)
+    {
+        candidate_mask base;
+        for (unsigned j = 0; j < this->Size_; ++j)
+        {
+            base.insert(baseLines[chosen[j]] + 1);
+        }
+
+        // The digit is in one of the base lines in each cover line.
+        const auto digitMask = candidate_mask::single(digit);
+        const auto coverFirstUnit = rows ? Side : 0;
+        for (auto remaining = coverLines; !remaining.empty(); )
+        {
+            const auto cover = coverFirstUnit + remaining.pop_lowest() - 1;
+            for (auto outside = and_not(board.positions(digit, cover), base); !outside.empty(); )
+            {
+                const auto cell = board_type::unit_cell(cover, outside.pop_lowest() - 1);
+                deduction.Eliminations.push_back(typename deduction_type::Elimination { static_cast<std::uint16_t>(cell), digitMask });
+            }
+        }
+
+        if (deduction.Eliminations.empty())
+            return false;
+
+        for (unsigned j = 0; j < this->Size_; ++j)
+        {
+            const auto line = firstUnit + baseLines[chosen[j]];
+            for (auto remaining = board.positions(digit, line); !remaining.empty(); )
+            {
+                deduction.Cells.push_back(static_cast<std::uint16_t>(board_type::unit_cell(line, remaining.pop_lowest() - 1)));
+            }
+        }
+
+        deduction.Unit = firstUnit + baseLines[chosen[0]];
+        deduction.Digits = digitMask;
+        return true;
+    };
+
+    return find_locked_set(masks, count, this->Size_, 0, 0, candidate_mask(), chosen, found);
+}
+
+template <unsigned Side>
+BasicTechniquePipeline<Side>::BasicTechniquePipeline(TechniqueSet techniques) noexcept
+    : Techniques_(techniques)
+{ }
+
+template <unsigned Side>
+TechniqueSet BasicTechniquePipeline<Side>::techniques() const noexcept
+{
+    return this->Techniques_;
+}
+
+template <unsigned Side>
+const typename BasicTechniquePipeline<Side>::strategy_type& BasicTechniquePipeline<Side>::technique(Technique kind) const noexcept
+{
+    return const_cast<BasicTechniquePipeline*>(this)->strategy(kind);
+}
+
+template <unsigned Side>
+typename BasicTechniquePipeline<Side>::strategy_type& BasicTechniquePipeline<Side>::strategy(Technique kind) noexcept
+{
+    switch (kind)
+    {
+    case Technique::NakedSingle:
+        return this->NakedSingle_;
+    case Technique::HiddenSingle:
+        return this->HiddenSingle_;
+    case Technique::Pointing:
+        return this->Pointing_;
+    case Technique::Claiming:
+        return this->Claiming_;
+    case Technique::NakedPair:
+        return this->NakedPair_;
+    case Technique::XWing:
+        return this->XWing_;
+    case Technique::HiddenPair:
+        return this->HiddenPair_;
+    case Technique::NakedTriple:
+        return this->NakedTriple_;
+    case Technique::Swordfish:
+        return this->Swordfish_;
+    case Technique::HiddenTriple:
+        return this->HiddenTriple_;
+    case Technique::NakedQuad:
+        return this->NakedQuad_;
+    case Technique::Jellyfish:
+        return this->Jellyfish_;
+    case Technique::HiddenQuad:
+        return this->HiddenQuad_;
+    }
+
+    assert(false && "Unknown technique");
+    return this->NakedSingle_;
+}
+
+template <unsigned Side>
+bool BasicTechniquePipeline<Side>::find(const board_type& board, deduction_type& deduction)
+{
+    for (unsigned i = 0; i < TechniqueCount; ++i)
+    {
+        const auto kind = static_cast<Technique>(i);
+        if (this->Techniques_.contains(kind) && this->strategy(kind).find(board, deduction))
+            return true;
+    }
+
+    return false;
+}
+
+template <unsigned Side>
+void BasicTechniquePipeline<Side>::reset() noexcept
+{
+    for (unsigned i = 0; i < TechniqueCount; ++i)
+    {
+        this->strategy(static_cast<Technique>(i)).reset();
+    }
+}
+
+template class BasicTechniqueStrategy<4>;
+template class BasicTechniqueStrategy<9>;
+template class BasicTechniqueStrategy<16>;
+template class BasicTechniqueStrategy<25>;
+
+template class BasicUnitTechnique<4>;
+template class BasicUnitTechnique<9>;
+template class BasicUnitTechnique<16>;
+template class BasicUnitTechnique<25>;
+
+template class BasicNakedSingle<4>;
+template class BasicNakedSingle<9>;
+template class BasicNakedSingle<16>;
+template class BasicNakedSingle<25>;
+
+template class BasicHiddenSingle<4>;
+template class BasicHiddenSingle<9>;
+template class BasicHiddenSingle<16>;
+template class BasicHiddenSingle<25>;
+
+template class BasicPointing<4>;
+template class BasicPointing<9>;
+template class BasicPointing<16>;
+template class BasicPointing<25>;
+
+template class BasicClaiming<4>;
+template class BasicClaiming<9>;
+template class BasicClaiming<16>;
+template class BasicClaiming<25>;
+
+template class BasicNakedSubset<4>;
+template class BasicNakedSubset<9>;
+template class BasicNakedSubset<16>;
+template class BasicNakedSubset<25>;
+
+template class BasicHiddenSubset<4>;
+template class BasicHiddenSubset<9>;
+template class BasicHiddenSubset<16>;
+template class BasicHiddenSubset<25>;
+
+template class BasicFish<4>;
+template class BasicFish<9>;
+template class BasicFish<16>;
+template class BasicFish<25>;
+
+template class BasicTechniquePipeline<4>;
+template class BasicTechniquePipeline<9>;
+template class BasicTechniquePipeline<16>;
+template class BasicTechniquePipeline<25>;
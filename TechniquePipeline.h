@@ -0,0 +1,248 @@
+#pragma once
+
+#include "CandidateBoard.h"
+#include "Deduction.h"
+#include "Technique.h"
+
+#include <cstdint>
+
+/// @brief A solving technique: finds one deduction at a time on a board.
+template <unsigned Side>
+class BasicTechniqueStrategy
+{
+public:
+    using board_type = BasicCandidateBoard<Side>;
+    using deduction_type = BasicDeduction<Side>;
+
+    explicit BasicTechniqueStrategy(Technique kind) noexcept;
+
+    BasicTechniqueStrategy(const BasicTechniqueStrategy&) = default;
+    BasicTechniqueStrategy& operator=(const BasicTechniqueStrategy&) = default;
+
+    virtual ~BasicTechniqueStrategy() = default;
+
+    Technique kind() const noexcept;
+    const TechniqueStats& stats() const noexcept;
+
+    /// @brief Look for a deduction which places a digit or removes some
+    /// candidates of @p board, and count it in stats().
+    /// @return false if there's none.
+    bool find(const board_type& board, deduction_type& deduction);
+
+    /// @brief Forget what was looked at, e.g. before moving to another board.
+    virtual void reset() noexcept;
+
+protected:
+    virtual bool search(const board_type& board, deduction_type& deduction) = 0;
+
+private:
+    Technique Kind_;
+    TechniqueStats Stats_;
+};
+
+/// @brief A technique which looks at one unit at a time.
+///
+/// The version of each unit is kept when nothing was found there, so that
+/// the unit is skipped until one of its candidates goes.
+template <unsigned Side>
+class BasicUnitTechnique : public BasicTechniqueStrategy<Side>
+{
+public:
+    using typename BasicTechniqueStrategy<Side>::board_type;
+    using typename BasicTechniqueStrategy<Side>::deduction_type;
+
+    /// @param firstUnit, lastUnit The units [firstUnit, lastUnit) looked at.
+    BasicUnitTechnique(Technique kind, unsigned firstUnit, unsigned lastUnit) noexcept;
+
+    void reset() noexcept override;
+
+protected:
+    bool search(const board_type& board, deduction_type& deduction) override;
+
+    virtual bool find_in_unit(const board_type& board, unsigned unit, deduction_type& deduction) const = 0;
+
+private:
+    unsigned FirstUnit_ = 0;
+    unsigned LastUnit_ = 0;
+    std::uint32_t CheckedVersions_[board_type::UnitCount] = {};
+};
+
+/// @brief A cell with a single candidate. The board keeps track of them.
+template <unsigned Side>
+class BasicNakedSingle final : public BasicTechniqueStrategy<Side>
+{
+public:
+    using typename BasicTechniqueStrategy<Side>::board_type;
+    using typename BasicTechniqueStrategy<Side>::deduction_type;
+
+    BasicNakedSingle() noexcept;
+
+protected:
+    bool search(const board_type& board, deduction_type& deduction) override;
+};
+
+/// @brief A digit which fits only one cell of a unit. Also reports units
+/// with no room left for a digit.
+template <unsigned Side>
+class BasicHiddenSingle final : public BasicUnitTechnique<Side>
+{
+public:
+    using typename BasicUnitTechnique<Side>::board_type;
+    using typename BasicUnitTechnique<Side>::deduction_type;
+
+    BasicHiddenSingle() noexcept;
+
+protected:
+    bool find_in_unit(const board_type& board, unsigned unit, deduction_type& deduction) const override;
+};
+
+/// @brief A candidate confined to one row (or column) of a subgrid can't
+/// go anywhere else in that row (or column).
+template <unsigned Side>
+class BasicPointing final : public BasicUnitTechnique<Side>
+{
+public:
+    using typename BasicUnitTechnique<Side>::board_type;
+    using typename BasicUnitTechnique<Side>::deduction_type;
+
+    BasicPointing() noexcept;
+
+protected:
+    bool find_in_unit(const board_type& board, unsigned unit, deduction_type& deduction) const override;
+};
+
+/// @brief A candidate confined to one subgrid along a row (or column)
+/// can't go anywhere else in that subgrid.
+template <unsigned Side>
+class BasicClaiming final : public BasicUnitTechnique<Side>
+{
+public:
+    using typename BasicUnitTechnique<Side>::board_type;
+    using typename BasicUnitTechnique<Side>::deduction_type;
+
+    BasicClaiming() noexcept;
+
+protected:
+    bool find_in_unit(const board_type& board, unsigned unit, deduction_type& deduction) const override;
+};
+
+/// @brief N cells of a unit with N candidates between them: those
+/// candidates can't go anywhere else in the unit.
+template <unsigned Side>
+class BasicNakedSubset final : public BasicUnitTechnique<Side>
+{
+public:
+    using typename BasicUnitTechnique<Side>::board_type;
+    using typename BasicUnitTechnique<Side>::deduction_type;
+
+    /// @param kind NakedPair, NakedTriple or NakedQuad.
+    explicit BasicNakedSubset(Technique kind) noexcept;
+
+protected:
+    bool find_in_unit(const board_type& board, unsigned unit, deduction_type& deduction) const override;
+
+private:
+    unsigned Size_ = 2;
+};
+
+/// @brief N digits which fit only N cells of a unit: no other candidate
+/// can go in those cells.
+template <unsigned Side>
+class BasicHiddenSubset final : public BasicUnitTechnique<Side>
+{
+public:
+    using typename BasicUnitTechnique<Side>::board_type;
+    using typename BasicUnitTechnique<Side>::deduction_type;
+
+    /// @param kind HiddenPair, HiddenTriple or HiddenQuad.
+    explicit BasicHiddenSubset(Technique kind) noexcept;
+
+protected:
+    bool find_in_unit(const board_type& board, unsigned unit, deduction_type& deduction) const override;
+
+private:
+    unsigned Size_ = 2;
+};
+
+/// @brief N rows where a digit fits only within the same N columns: it
+/// can't go anywhere else in those columns. Likewise with rows and columns
+/// swapped.
+///
+/// Each digit is looked at through the board's positions: the columns
+/// where it fits in each row, and the rows where it fits in each column,
+/// so that a candidate pattern is checked with a few mask operations. A
+/// digit is only searched again once its positions changed.
+template <unsigned Side>
+class BasicFish final : public BasicTechniqueStrategy<Side>
+{
+public:
+    using typename BasicTechniqueStrategy<Side>::board_type;
+    using typename BasicTechniqueStrategy<Side>::deduction_type;
+
+    /// @param kind XWing, Swordfish or Jellyfish.
+    explicit BasicFish(Technique kind) noexcept;
+
+    void reset() noexcept override;
+
+protected:
+    bool search(const board_type& board, deduction_type& deduction) override;
+
+private:
+    using candidate_mask = typename board_type::candidate_mask;
+
+    /// @param rows Whether the base lines are rows, or else columns.
+    bool find_in_lines(const board_type& board, unsigned digit, bool rows, deduction_type& deduction) const;
+
+    unsigned Size_ = 2;
+    std::uint32_t CheckedVersion_ = 0;
+
+    // The positions along each row of each digit, when it was last
+    // searched without success.
+    candidate_mask CheckedRows_[Side][Side] = {};
+};
+
+/// @brief Runs the enabled techniques in order of cost.
+///
+/// Each call to find() starts over from the cheapest technique, so an
+/// expensive one only runs when all the cheaper ones are stuck.
+template <unsigned Side>
+class BasicTechniquePipeline final
+{
+public:
+    using board_type = BasicCandidateBoard<Side>;
+    using deduction_type = BasicDeduction<Side>;
+    using strategy_type = BasicTechniqueStrategy<Side>;
+
+    explicit BasicTechniquePipeline(TechniqueSet techniques = TechniqueSet::all()) noexcept;
+
+    TechniqueSet techniques() const noexcept;
+    const strategy_type& technique(Technique kind) const noexcept;
+
+    /// @brief Ask the enabled techniques for a deduction, cheapest first.
+    /// @return false if none of them makes progress.
+    bool find(const board_type& board, deduction_type& deduction);
+
+    /// @brief Forget what the techniques looked at. Their stats are kept.
+    void reset() noexcept;
+
+private:
+    strategy_type& strategy(Technique kind) noexcept;
+
+    TechniqueSet Techniques_;
+
+    BasicNakedSingle<Side> NakedSingle_;
+    BasicHiddenSingle<Side> HiddenSingle_;
+    BasicPointing<Side> Pointing_;
+    BasicClaiming<Side> Claiming_;
+    BasicNakedSubset<Side> NakedPair_ { Technique::NakedPair };
+    BasicFish<Side> XWing_ { Technique::XWing };
+    BasicHiddenSubset<Side> HiddenPair_ { Technique::HiddenPair };
+    BasicNakedSubset<Side> NakedTriple_ { Technique::NakedTriple };
+    BasicFish<Side> Swordfish_ { Technique::Swordfish };
+    BasicHiddenSubset<Side> HiddenTriple_ { Technique::HiddenTriple };
+    BasicNakedSubset<Side> NakedQuad_ { Technique::NakedQuad };
+    BasicFish<Side> Jellyfish_ { Technique::Jellyfish };
+    BasicHiddenSubset<Side> HiddenQuad_ { Technique::HiddenQuad };
+};
+
+using TechniquePipeline = BasicTechniquePipeline<9>;
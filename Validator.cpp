@@ -1,103 +1,176 @@
 #include "Validator.h"
 
+#include "DigitMask.h"
+#include "GridLayout.h"
 #include "SudokuGrid.h"
 
-#include <algorithm>
-#include <iterator>
-#include <utility>
-
-Validator::Validator(const SudokuGrid& grid)
-    : Grid_(&grid)
-{ }
+#include <cassert>
 
 namespace
 {
 
-template <typename It>
-std::pair<It, It> duplicate_non_empty_cells(It begin, It end)
+/// The cells reported when there's no conflict.
+constexpr MatrixPoint<unsigned> NoDuplicate;
+
+template <unsigned Side>
+using unit_mask = typename BasicDigitMask<Side>::storage_type;
+
+/// @brief The bit of @p value in a unit mask, or 0 for an empty cell.
+template <unsigned Side>
+constexpr unit_mask<Side> digit_bit(char value) noexcept
 {
-    for (; begin != end; ++begin)
-    {
-        if (!is_empty(*begin))
-        {
-            auto it = std::find(std::next(begin), end, *begin);
-            if (end != it)
-            {
-                return std::make_pair(begin, it);
-            }
-        }
-    }
+    return is_empty(value) ? unit_mask<Side>(0) : BasicDigitMask<Side>::single(static_cast<unsigned>(value)).bits();
+}
 
-    return std::make_pair(end, end);
+/// @brief The cell of index @p i (in row-major order) of the @p unit-th
+/// unit: rows come first, then columns, then subgrids.
+template <unsigned Side>
+MatrixPoint<unsigned> unit_cell(unsigned unit, unsigned i) noexcept
+{
+    const auto cell = BasicGridLayout<Side>::unit_cell(unit, i);
+    return MatrixPoint<unsigned>(cell / Side, cell % Side);
 }
 
 }
 
-bool Validator::validate()
+template <unsigned Side>
+BasicValidator<Side>::BasicValidator(const grid_type& grid)
+    : Grid_(&grid)
+{ }
+
+template <unsigned Side>
+bool BasicValidator<Side>::validate()
 {
-    for (unsigned r = 0; r < SudokuGrid::rows(); ++r)
-    {
-        const auto begin = this->Grid_->row_cbegin(r);
-        const auto duplicates = duplicate_non_empty_cells(begin, this->Grid_->row_cend(r));
-        if (duplicates.first != duplicates.second)
-        {
-            this->FirstDuplicate_.Row = r;
-            this->FirstDuplicate_.Column = std::distance(begin, duplicates.first);
+    using mask_type = unit_mask<Side>;
+    using layout_type = BasicGridLayout<Side>;
+    const auto& grid = *this->Grid_;
 
-            this->SecondDuplicate_.Row = r;
-            this->SecondDuplicate_.Column = std::distance(begin, duplicates.second);
+    this->Conflicts_.clear();
 
-            return false;
+    // The digits seen in each unit, and those seen more than once.
+    mask_type seen[3 * Side] = {};
+    mask_type duplicates[3 * Side] = {};
+    const auto* values = &grid[0][0];
+    for (unsigned cell = 0; cell < Side * Side; ++cell)
+    {
+        const auto bit = digit_bit<Side>(values[cell]);
+        const unsigned units[] = { layout_type::row_unit(cell), layout_type::column_unit(cell), layout_type::subgrid_unit(cell) };
+        for (const auto unit : units)
+        {
+            duplicates[unit] = static_cast<mask_type>(duplicates[unit] | (seen[unit] & bit));
+            seen[unit] = static_cast<mask_type>(seen[unit] | bit);
         }
     }
 
-    for (unsigned c = 0; c < SudokuGrid::columns(); ++c)
+    mask_type anyDuplicate = 0;
+    for (const auto unitDuplicates : duplicates)
     {
-        const auto begin = this->Grid_->column_cbegin(c);
-        const auto duplicates = duplicate_non_empty_cells(begin, this->Grid_->column_end(c));
-        if (duplicates.first != duplicates.second)
-        {
-            this->FirstDuplicate_.Row = std::distance(begin, duplicates.first);
-            this->FirstDuplicate_.Column = c;
-
-            this->SecondDuplicate_.Row = std::distance(begin, duplicates.second);
-            this->SecondDuplicate_.Column = c;
-
-            return false;
-        }
+        anyDuplicate = static_cast<mask_type>(anyDuplicate | unitDuplicates);
     }
 
-    for (unsigned r = 0; r < SudokuGridSide; r += SudokuSubgridSide)
+    if (0 == anyDuplicate)
+        return true;
+
+    for (unsigned unit = 0; unit < 3 * Side; ++unit)
     {
-        for (unsigned c = 0; c < SudokuGridSide; c += SudokuSubgridSide)
+        if (0 == duplicates[unit])
+            continue;
+
+        for (unsigned i = 0; i < Side; ++i)
         {
-            const auto begin = this->Grid_->subgrid_cbegin<SudokuSubgridSide, SudokuSubgridSide>(r,c);
-            const auto end = this->Grid_->subgrid_cend<SudokuSubgridSide, SudokuSubgridSide>(r,c);
-            const auto duplicates = duplicate_non_empty_cells(begin, end);
-            if (duplicates.first != duplicates.second)
+            const auto first = unit_cell<Side>(unit, i);
+            const auto value = grid[first.Row][first.Column];
+            if (0 == (duplicates[unit] & digit_bit<Side>(value)))
+                continue;
+
+            for (auto j = i + 1; j < Side; ++j)
             {
-                const auto i = std::distance(begin, duplicates.first);
-                this->FirstDuplicate_.Row = r + i / SudokuSubgridSide;
-                this->FirstDuplicate_.Column = c + i % SudokuSubgridSide;
+                const auto second = unit_cell<Side>(unit, j);
+                if (value != grid[second.Row][second.Column])
+                    continue;
 
-                const auto j = std::distance(begin, duplicates.first);
-                this->SecondDuplicate_.Row = r + j / SudokuSubgridSide;
-                this->SecondDuplicate_.Column = c + j % SudokuSubgridSide;
+                // Cells in the same row or column are reported for that unit.
+                const auto isSubgrid = unit >= 2 * Side;
+                if (isSubgrid && (first.Row == second.Row || first.Column == second.Column))
+                    continue;
 
-                return false;
+                this->Conflicts_.push_back(Conflict { first, second });
             }
         }
     }
 
-    return true;
+    assert(!this->Conflicts_.empty());
+    return false;
+}
+
+template <unsigned Side>
+const std::vector<typename BasicValidator<Side>::Conflict>& BasicValidator<Side>::conflicts() const noexcept
+{
+    return this->Conflicts_;
+}
+
+template <unsigned Side>
+const MatrixPoint<unsigned>& BasicValidator<Side>::firstDuplicate() const noexcept
+{
+    return this->Conflicts_.empty() ? NoDuplicate : this->Conflicts_.front().First;
 }
 
-const MatrixPoint<unsigned>& Validator::firstDuplicate() const noexcept
+template <unsigned Side>
+const MatrixPoint<unsigned>& BasicValidator<Side>::secondDuplicate() const noexcept
 {
-    return this->FirstDuplicate_;
+    return this->Conflicts_.empty() ? NoDuplicate : this->Conflicts_.front().Second;
+}
+
+template <unsigned Side>
+bool BasicValidator<Side>::is_solution(const grid_type& grid) noexcept
+{
+    using mask_type = unit_mask<Side>;
+
+    mask_type rows[Side] = {};
+    mask_type columns[Side] = {};
+    mask_type subgrids[Side] = {};
+    for (unsigned r = 0; r < Side; ++r)
+    {
+        for (unsigned c = 0; c < Side; ++c)
+        {
+            const auto subgrid = BasicGridLayout<Side>::subgrid(r * Side + c);
+            const auto bit = digit_bit<Side>(grid[r][c]);
+            rows[r] = static_cast<mask_type>(rows[r] | bit);
+            columns[c] = static_cast<mask_type>(columns[c] | bit);
+            subgrids[subgrid] = static_cast<mask_type>(subgrids[subgrid] | bit);
+        }
+    }
+
+    // Side cells hold Side different digits only if there's no duplicate
+    // and no empty cell.
+    auto all = BasicDigitMask<Side>::all().bits();
+    for (unsigned i = 0; i < Side; ++i)
+    {
+        all = static_cast<mask_type>(all & rows[i] & columns[i] & subgrids[i]);
+    }
+
+    return BasicDigitMask<Side>::all().bits() == all;
 }
 
-const MatrixPoint<unsigned>& Validator::secondDuplicate() const noexcept
+template <unsigned Side>
+std::size_t BasicValidator<Side>::validate_solutions(const grid_type* grids, std::size_t count, bool* results) noexcept
 {
-    return this->SecondDuplicate_;
+    std::size_t solutions = 0;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const auto solution = is_solution(grids[i]);
+        solutions += solution ? 1 : 0;
+
+        if (nullptr != results)
+        {
+            results[i] = solution;
+        }
+    }
+
+    return solutions;
 }
+
+template class BasicValidator<4>;
+template class BasicValidator<9>;
+template class BasicValidator<16>;
+template class BasicValidator<25>;
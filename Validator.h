@@ -4,26 +4,64 @@
 
 #include "MatrixPoint.h" // IWYU pragma: export
 
-class Validator final
+#include <cstddef>
+#include <vector>
+
+/// @brief Checks that no digit occurs twice in a row, column or subgrid.
+///
+/// The digits of every unit are gathered in bit masks in a single pass over
+/// the grid, so a valid grid is confirmed without comparing cells. Cells
+/// are only compared within the units which hold a duplicate digit.
+template <unsigned Side>
+class BasicValidator final
 {
 public:
-    explicit Validator(const SudokuGrid& grid);
+    using grid_type = BasicSudokuGrid<Side>;
+
+    /// @brief Two cells of the same unit holding the same digit.
+    struct Conflict
+    {
+        MatrixPoint<unsigned> First;
+        MatrixPoint<unsigned> Second;
+    };
 
-    Validator(const Validator&) = delete;
-    Validator(Validator&&) = delete;
+    explicit BasicValidator(const grid_type& grid);
 
-    Validator& operator=(const Validator&) = delete;
-    Validator& operator=(Validator&&) = delete;
+    BasicValidator(const BasicValidator&) = delete;
+    BasicValidator(BasicValidator&&) = delete;
 
-    ~Validator() = default;
+    BasicValidator& operator=(const BasicValidator&) = delete;
+    BasicValidator& operator=(BasicValidator&&) = delete;
 
+    ~BasicValidator() = default;
+
+    /// @brief Check the grid and collect all its conflicts.
+    /// @return true if there's none. Empty cells are fine.
     bool validate();
 
+    /// @brief The conflicts found by the last validate(), in row, column
+    /// and subgrid order. Two cells sharing a row or a column are reported
+    /// once, even if they share the subgrid, too.
+    const std::vector<Conflict>& conflicts() const noexcept;
+
+    /// @brief The cells of the first conflict, or (0, 0) if the last
+    /// validate() found none, or validate() wasn't called yet.
     const MatrixPoint<unsigned>& firstDuplicate() const noexcept;
     const MatrixPoint<unsigned>& secondDuplicate() const noexcept;
+
+    /// @brief Whether @p grid is complete and valid, i.e. every unit holds
+    /// every digit.
+    static bool is_solution(const grid_type& grid) noexcept;
+
+    /// @brief Check @p count complete grids with is_solution().
+    /// @param results If not null, results[i] tells whether grids[i] is a solution.
+    /// @return The number of solutions.
+    static std::size_t validate_solutions(const grid_type* grids, std::size_t count, bool* results = nullptr) noexcept;
+
 private:
-    const SudokuGrid* Grid_ { nullptr };
+    const grid_type* Grid_ { nullptr };
 
-    MatrixPoint<unsigned> FirstDuplicate_;
-    MatrixPoint<unsigned> SecondDuplicate_;
+    std::vector<Conflict> Conflicts_;
 };
+
+using Validator = BasicValidator<9>;
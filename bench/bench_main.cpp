@@ -0,0 +1,663 @@
+// This file is the benchmark entry point.
+//
+// Every solver is run over the bundled grids (data/*.txt), over a corpus
+// generated from them and over any corpus file given on the command line.
+// See print_usage() for the options.
+
+#include "AllocationCounter.h"
+#include "BacktrackingSolver.h"
+#include "ConstrainSolver.h"
+#include "DlxSolver.h"
+#include "LockstepSolver.h"
+#include "PackedCorpus.h"
+#include "PuzzleReader.h"
+#include "SolutionCache.h"
+#include "SudokuGrid.h"
+#include "Tag.h"
+#include "Technique.h"
+#include "Validator.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+
+struct Options
+{
+    unsigned Warmup = 1;
+    unsigned Repetitions = 5;
+    unsigned Generated = 500;
+    unsigned Seed = 1;
+    const char* JsonPath = nullptr;
+    TechniqueSet Techniques = TechniqueSet::all();
+    LockstepSolver::InstructionSet InstructionSet = LockstepSolver::best_instruction_set();
+    std::vector<std::string> Solvers;
+    std::vector<std::string> Corpora;
+};
+
+struct Measurement
+{
+    std::string Corpus;
+    unsigned Side = 0;
+    std::size_t Puzzles = 0;
+    std::string Solver;
+    std::size_t Solved = 0;
+
+    double NsPerPuzzle = 0;
+    double PuzzlesPerSecond = 0;
+    std::uint64_t P50Ns = 0;
+    std::uint64_t P90Ns = 0;
+    std::uint64_t P99Ns = 0;
+    std::uint64_t MaxNs = 0;
+
+    double AllocationsPerPuzzle = 0;
+    double BytesPerPuzzle = 0;
+};
+
+std::uint64_t percentile(const std::vector<std::uint64_t>& sortedTimes, unsigned percent)
+{
+    // Nearest-rank percentile.
+    const auto rank = (percent * sortedTimes.size() + 99) / 100;
+    return sortedTimes[std::max<std::size_t>(rank, 1) - 1];
+}
+
+/// @brief Fill in the statistics of @p measurement from the time of each
+/// run, which get sorted.
+void summarize(Measurement& measurement, std::vector<std::uint64_t>& times, std::uint64_t totalNs, unsigned long allocations, unsigned long bytes)
+{
+    const auto runs = static_cast<double>(times.size());
+    measurement.NsPerPuzzle = static_cast<double>(totalNs) / runs;
+    measurement.PuzzlesPerSecond = 0 == totalNs ? 0 : runs * 1e9 / static_cast<double>(totalNs);
+    measurement.AllocationsPerPuzzle = static_cast<double>(allocations) / runs;
+    measurement.BytesPerPuzzle = static_cast<double>(bytes) / runs;
+
+    std::sort(times.begin(), times.end());
+    measurement.P50Ns = percentile(times, 50);
+    measurement.P90Ns = percentile(times, 90);
+    measurement.P99Ns = percentile(times, 99);
+    measurement.MaxNs = times.back();
+}
+
+template <typename SolverType>
+SolverType make_solver(Tag<SolverType>, const Options&)
+{
+    return SolverType();
+}
+
+template <unsigned Side>
+BasicConstrainSolver<Side> make_solver(Tag<BasicConstrainSolver<Side>>, const Options& options)
+{
+    return BasicConstrainSolver<Side>(options.Techniques);
+}
+
+template <typename SolverType>
+Measurement measure(const std::vector<typename SolverType::grid_type>& grids, const Options& options)
+{
+    using grid_type = typename SolverType::grid_type;
+    using clock = std::chrono::steady_clock;
+
+    Measurement measurement;
+    measurement.Puzzles = grids.size();
+
+    // A single solver is reset() for each grid, as a long-lived one would.
+    auto solver = make_solver(Tag<SolverType>(), options);
+
+    grid_type copy;
+    for (unsigned w = 0; w < options.Warmup; ++w)
+    {
+        for (const auto& grid : grids)
+        {
+            solver.solve(grid, copy);
+        }
+    }
+
+    std::vector<std::uint64_t> times;
+    times.reserve(grids.size() * options.Repetitions);
+
+    const auto allocationsBefore = allocation_count();
+    const auto bytesBefore = allocated_bytes();
+
+    std::uint64_t totalNs = 0;
+    for (unsigned rep = 0; rep < options.Repetitions; ++rep)
+    {
+        for (const auto& grid : grids)
+        {
+            const auto start = clock::now();
+            const auto solved = solver.solve(grid, copy);
+            const auto end = clock::now();
+
+            const auto ns = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+            times.push_back(ns);
+            totalNs += ns;
+
+            if (0 == rep && solved && BasicValidator<grid_type::sideLength()>(copy).validate())
+            {
+                ++measurement.Solved;
+            }
+        }
+    }
+
+    summarize(measurement, times, totalNs, allocation_count() - allocationsBefore, allocated_bytes() - bytesBefore);
+    return measurement;
+}
+
+/// @brief Time LockstepSolver one group at a time: each grid of a group is
+/// counted as taking its share of the group's time.
+Measurement measure_lockstep(const std::vector<SudokuGrid>& grids, const Options& options)
+{
+    using clock = std::chrono::steady_clock;
+
+    const LockstepSolver solver(options.InstructionSet);
+    std::vector<BatchResult> results(grids.size());
+
+    Measurement measurement;
+    measurement.Puzzles = grids.size();
+
+    for (unsigned w = 0; w < options.Warmup; ++w)
+    {
+        auto copy = grids;
+        solver.solve(copy.data(), results.data(), copy.size());
+    }
+
+    std::vector<std::uint64_t> times;
+    times.reserve(grids.size() * options.Repetitions);
+
+    auto copy = grids;
+    const auto allocationsBefore = allocation_count();
+    const auto bytesBefore = allocated_bytes();
+
+    std::uint64_t totalNs = 0;
+    for (unsigned rep = 0; rep < options.Repetitions; ++rep)
+    {
+        std::copy(grids.cbegin(), grids.cend(), copy.begin());
+        for (std::size_t first = 0; first < copy.size(); first += LockstepSolver::GroupSize)
+        {
+            const auto count = std::min<std::size_t>(copy.size() - first, LockstepSolver::GroupSize);
+
+            const auto start = clock::now();
+            solver.solve(copy.data() + first, results.data() + first, count);
+            const auto end = clock::now();
+
+            const auto ns = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+            times.insert(times.end(), count, ns / count);
+            totalNs += ns;
+        }
+
+        if (0 == rep)
+        {
+            for (std::size_t i = 0; i < copy.size(); ++i)
+            {
+                if (results[i].Solved && Validator(copy[i]).validate())
+                {
+                    ++measurement.Solved;
+                }
+            }
+        }
+    }
+
+    summarize(measurement, times, totalNs, allocation_count() - allocationsBefore, allocated_bytes() - bytesBefore);
+    return measurement;
+}
+
+/// @brief Time CachedSolver in front of the constrain solver. Each
+/// repetition starts with an empty cache: only grids equivalent to one met
+/// before in the same repetition are hits.
+Measurement measure_cached(const std::vector<SudokuGrid>& grids, const Options& options)
+{
+    using clock = std::chrono::steady_clock;
+
+    SolutionCache cache(grids.size());
+
+    Measurement measurement;
+    measurement.Puzzles = grids.size();
+
+    CachedSolver<ConstrainSolver> solver(cache);
+
+    SudokuGrid copy;
+    for (unsigned w = 0; w < options.Warmup; ++w)
+    {
+        cache.clear();
+        for (const auto& grid : grids)
+        {
+            solver.solve(grid, copy);
+        }
+    }
+
+    std::vector<std::uint64_t> times;
+    times.reserve(grids.size() * options.Repetitions);
+
+    const auto allocationsBefore = allocation_count();
+    const auto bytesBefore = allocated_bytes();
+
+    std::uint64_t totalNs = 0;
+    for (unsigned rep = 0; rep < options.Repetitions; ++rep)
+    {
+        cache.clear();
+        for (const auto& grid : grids)
+        {
+            const auto start = clock::now();
+            const auto solved = solver.solve(grid, copy);
+            const auto end = clock::now();
+
+            const auto ns = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+            times.push_back(ns);
+            totalNs += ns;
+
+            if (0 == rep && solved && Validator(copy).validate())
+            {
+                ++measurement.Solved;
+            }
+        }
+    }
+
+    summarize(measurement, times, totalNs, allocation_count() - allocationsBefore, allocated_bytes() - bytesBefore);
+    return measurement;
+}
+
+// Only 9x9 grids fit the lanes of LockstepSolver, and have a canonical
+// form for CachedSolver.
+template <typename Run, unsigned Side>
+void run_9x9_solvers(Run&, const std::vector<BasicSudokuGrid<Side>>&)
+{ }
+
+template <typename Run>
+void run_9x9_solvers(Run& run, const std::vector<SudokuGrid>&)
+{
+    run("lockstep", &measure_lockstep);
+    run("cached", &measure_cached);
+}
+
+bool solver_selected(const Options& options, const char* name)
+{
+    return options.Solvers.empty() ||
+           std::find(options.Solvers.cbegin(), options.Solvers.cend(), name) != options.Solvers.cend();
+}
+
+void print_measurement(const Measurement& m)
+{
+    printf("%-32s %4u %8zu  %-12s %8zu %12.0f %12.0f %10llu %10llu %10llu %10llu %10.1f %12.1f\n",
+           m.Corpus.c_str(), m.Side, m.Puzzles, m.Solver.c_str(), m.Solved,
+           m.NsPerPuzzle, m.PuzzlesPerSecond,
+           static_cast<unsigned long long>(m.P50Ns),
+           static_cast<unsigned long long>(m.P90Ns),
+           static_cast<unsigned long long>(m.P99Ns),
+           static_cast<unsigned long long>(m.MaxNs),
+           m.AllocationsPerPuzzle, m.BytesPerPuzzle);
+    fflush(stdout);
+}
+
+template <unsigned Side>
+void bench_corpus(const std::string& name,
+                  const std::vector<BasicSudokuGrid<Side>>& grids,
+                  const Options& options,
+                  std::vector<Measurement>& measurements)
+{
+    const auto run = [&](const char* solverName, auto measureSolver)
+    {
+        if (!solver_selected(options, solverName))
+            return;
+
+        auto measurement = measureSolver(grids, options);
+        measurement.Corpus = name;
+        measurement.Side = Side;
+        measurement.Solver = solverName;
+        print_measurement(measurement);
+        measurements.push_back(std::move(measurement));
+    };
+
+    run("constrain", &measure<BasicConstrainSolver<Side>>);
+
+    // Plain backtracking takes far too long on sparse large grids.
+    if (Side <= SudokuGridSide)
+    {
+        run("backtracking", &measure<BasicBacktrackingSolver<Side>>);
+    }
+
+    run("mrv", &measure<BasicMrvBacktrackingSolver<Side>>);
+    run("dlx", &measure<BasicDlxSolver<Side>>);
+    run_9x9_solvers(run, grids);
+}
+
+template <unsigned Side>
+bool read_corpus(const std::string& path, std::vector<BasicSudokuGrid<Side>>& grids)
+{
+    std::string errorMessage;
+    if (!read_puzzles(path.c_str(), grids, errorMessage))
+    {
+        fprintf(stderr, "%s\n", errorMessage.c_str());
+        return false;
+    }
+
+    for (const auto& grid : grids)
+    {
+        if (!BasicValidator<Side>(grid).validate())
+        {
+            fprintf(stderr, "Corpus '%s' holds an invalid grid\n", path.c_str());
+            return false;
+        }
+    }
+
+    return true;
+}
+
+template <unsigned Side>
+bool bench_file(const std::string& path, const Options& options, std::vector<Measurement>& measurements)
+{
+    std::vector<BasicSudokuGrid<Side>> grids;
+    if (!read_corpus(path, grids))
+        return false;
+
+    if (grids.empty())
+    {
+        fprintf(stderr, "No grid in corpus '%s'\n", path.c_str());
+        return false;
+    }
+
+    bench_corpus(path, grids, options, measurements);
+    return true;
+}
+
+bool bench_file(const std::string& path, const Options& options, std::vector<Measurement>& measurements)
+{
+    switch (detect_grid_side(path.c_str()))
+    {
+    case 4:
+        return bench_file<4>(path, options, measurements);
+    case 9:
+        return bench_file<9>(path, options, measurements);
+    case 16:
+        return bench_file<16>(path, options, measurements);
+    case 25:
+        return bench_file<25>(path, options, measurements);
+    default:
+        fprintf(stderr, "Cannot tell the grid size of corpus '%s'\n", path.c_str());
+        return false;
+    }
+}
+
+/// @brief A grid equivalent to @p grid: digits are relabelled, bands,
+/// stacks and the rows and columns within them are shuffled, and the grid
+/// may be transposed. All of these preserve validity and the number of
+/// solutions, but change the order in which the solvers meet the cells.
+SudokuGrid shuffled_grid(const SudokuGrid& grid, std::mt19937& generator)
+{
+    constexpr auto side = SudokuGrid::sideLength();
+    constexpr auto subgridSide = SudokuGrid::subgridSideLength();
+
+    const auto shuffled_lines = [&generator]()
+    {
+        unsigned blocks[subgridSide];
+        for (unsigned i = 0; i < subgridSide; ++i)
+        {
+            blocks[i] = i;
+        }
+        std::shuffle(blocks, blocks + subgridSide, generator);
+
+        std::vector<unsigned> lines;
+        for (const auto block : blocks)
+        {
+            unsigned offsets[subgridSide];
+            for (unsigned i = 0; i < subgridSide; ++i)
+            {
+                offsets[i] = i;
+            }
+            std::shuffle(offsets, offsets + subgridSide, generator);
+
+            for (const auto offset : offsets)
+            {
+                lines.push_back(block * subgridSide + offset);
+            }
+        }
+
+        return lines;
+    };
+
+    char digits[side + 1] = {};
+    for (unsigned d = 1; d <= side; ++d)
+    {
+        digits[d] = static_cast<char>(d);
+    }
+    std::shuffle(digits + 1, digits + side + 1, generator);
+
+    const auto rows = shuffled_lines();
+    const auto columns = shuffled_lines();
+    const auto transpose = 0 != generator() % 2;
+    SudokuGrid result;
+    for (unsigned r = 0; r < side; ++r)
+    {
+        for (unsigned c = 0; c < side; ++c)
+        {
+            const auto value = grid[rows[r]][columns[c]];
+            (transpose ? result[c][r] : result[r][c]) = digits[static_cast<unsigned>(value)];
+        }
+    }
+
+    return result;
+}
+
+std::string json_string(const std::string& s)
+{
+    std::string result = "\"";
+    for (const auto c : s)
+    {
+        if ('"' == c || '\\' == c)
+        {
+            result.push_back('\\');
+        }
+        result.push_back(c);
+    }
+    result.push_back('"');
+    return result;
+}
+
+bool write_json(const char* path, const Options& options, const std::vector<Measurement>& measurements)
+{
+    auto* file = std::fopen(path, "w");
+    if (nullptr == file)
+    {
+        fprintf(stderr, "Cannot write '%s'\n", path);
+        return false;
+    }
+
+    fprintf(file, "{\n");
+    fprintf(file, "  \"benchmark\": \"SudokuSolverBench\",\n");
+    fprintf(file, "  \"warmup\": %u,\n", options.Warmup);
+    fprintf(file, "  \"repetitions\": %u,\n", options.Repetitions);
+    fprintf(file, "  \"results\": [");
+    for (std::size_t i = 0; i < measurements.size(); ++i)
+    {
+        const auto& m = measurements[i];
+        fprintf(file, "%s\n    {", 0 == i ? "" : ",");
+        fprintf(file, "\"corpus\": %s, ", json_string(m.Corpus).c_str());
+        fprintf(file, "\"side\": %u, ", m.Side);
+        fprintf(file, "\"puzzles\": %zu, ", m.Puzzles);
+        fprintf(file, "\"solver\": %s, ", json_string(m.Solver).c_str());
+        fprintf(file, "\"solved\": %zu, ", m.Solved);
+        fprintf(file, "\"ns_per_puzzle\": %.1f, ", m.NsPerPuzzle);
+        fprintf(file, "\"puzzles_per_second\": %.1f, ", m.PuzzlesPerSecond);
+        fprintf(file, "\"p50_ns\": %llu, ", static_cast<unsigned long long>(m.P50Ns));
+        fprintf(file, "\"p90_ns\": %llu, ", static_cast<unsigned long long>(m.P90Ns));
+        fprintf(file, "\"p99_ns\": %llu, ", static_cast<unsigned long long>(m.P99Ns));
+        fprintf(file, "\"max_ns\": %llu, ", static_cast<unsigned long long>(m.MaxNs));
+        fprintf(file, "\"allocations_per_puzzle\": %.2f, ", m.AllocationsPerPuzzle);
+        fprintf(file, "\"bytes_per_puzzle\": %.1f}", m.BytesPerPuzzle);
+    }
+    fprintf(file, "\n  ]\n}\n");
+
+    return 0 == std::fclose(file);
+}
+
+void print_usage(const char* program)
+{
+    fprintf(stderr,
+        "Usage: %s [options] [corpus file...]\n"
+        "\n"
+        "Runs every solver over the bundled grids, a corpus generated from\n"
+        "them and the given corpus files.\n"
+        "\n"
+        "Options:\n"
+        "  --warmup N        untimed runs over each corpus (default: 1)\n"
+        "  --repetitions N   timed runs over each corpus (default: 5)\n"
+        "  --generate N      size of the generated corpus, 0 to skip it (default: 500)\n"
+        "  --seed N          seed of the generated corpus (default: 1)\n"
+        "  --solver NAME     only run constrain|backtracking|mrv|dlx|lockstep|\n"
+        "                    cached (repeatable)\n"
+        "  --techniques LIST techniques of the constrain solver, e.g.\n"
+        "                    naked-single,hidden-single (default: all)\n"
+        "  --isa NAME        instruction set of the lockstep solver:\n"
+        "                    scalar|sse2|avx2 (default: the best one)\n"
+        "  --no-bundled      skip the bundled grids\n"
+        "  --json FILE       write the results as JSON\n",
+        program);
+}
+
+bool parse_unsigned(const char* text, unsigned& value)
+{
+    // strtoul() would take a sign, or leading spaces, and negate the number.
+    if (!std::isdigit(static_cast<unsigned char>(*text)))
+        return false;
+
+    errno = 0;
+    char* end = nullptr;
+    const auto parsed = std::strtoul(text, &end, 10);
+    if ('\0' != *end || ERANGE == errno || parsed > std::numeric_limits<unsigned>::max())
+        return false;
+
+    value = static_cast<unsigned>(parsed);
+    return true;
+}
+
+bool parse_instruction_set(const char* name, LockstepSolver::InstructionSet& instructionSet)
+{
+    for (auto candidate : { LockstepSolver::InstructionSet::Scalar, LockstepSolver::InstructionSet::Sse2, LockstepSolver::InstructionSet::Avx2 })
+    {
+        if (0 == std::strcmp(name, instruction_set_name(candidate)))
+        {
+            instructionSet = candidate;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+    Options options;
+    bool bundled = true;
+
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    const auto* const program = argv[0];
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i]; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        const auto hasValue = i + 1 < argc;
+
+        bool valid = true;
+        if ("--warmup" == arg && hasValue)
+            valid = parse_unsigned(argv[++i], options.Warmup); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        else if ("--repetitions" == arg && hasValue)
+            valid = parse_unsigned(argv[++i], options.Repetitions) && 0 != options.Repetitions; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        else if ("--generate" == arg && hasValue)
+            valid = parse_unsigned(argv[++i], options.Generated); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        else if ("--seed" == arg && hasValue)
+            valid = parse_unsigned(argv[++i], options.Seed); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        else if ("--solver" == arg && hasValue)
+            options.Solvers.emplace_back(argv[++i]); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        else if ("--techniques" == arg && hasValue)
+            valid = TechniqueSet::parse(argv[++i], options.Techniques); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        else if ("--isa" == arg && hasValue)
+            valid = parse_instruction_set(argv[++i], options.InstructionSet); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        else if ("--json" == arg && hasValue)
+            options.JsonPath = argv[++i]; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        else if ("--no-bundled" == arg)
+            bundled = false;
+        else if (0 == arg.compare(0, 2, "--"))
+            valid = false;
+        else
+            options.Corpora.push_back(arg);
+
+        if (!valid)
+        {
+            print_usage(program);
+            return 1;
+        }
+    }
+
+    printf("%-32s %4s %8s  %-12s %8s %12s %12s %10s %10s %10s %10s %10s %12s\n",
+           "corpus", "side", "puzzles", "solver", "solved",
+           "ns/puzzle", "puzzles/s", "p50 ns", "p90 ns", "p99 ns", "max ns",
+           "allocs/puz", "bytes/puz");
+
+    std::vector<Measurement> measurements;
+    bool ok = true;
+
+    std::vector<SudokuGrid> seeds;
+    const char* seedPaths[] = {
+        SUDOKU_DATA_DIR "/easy_input.txt",
+        SUDOKU_DATA_DIR "/medium_input.txt",
+        SUDOKU_DATA_DIR "/hard_input.txt",
+        SUDOKU_DATA_DIR "/evil_input.txt"
+    };
+
+    const char* otherSizePaths[] = {
+        SUDOKU_DATA_DIR "/4x4_input.txt",
+        SUDOKU_DATA_DIR "/16x16_input.txt",
+        SUDOKU_DATA_DIR "/25x25_input.txt"
+    };
+
+    for (const auto* path : seedPaths)
+    {
+        ok = read_corpus(path, seeds) && ok;
+    }
+
+    if (bundled)
+    {
+        bench_corpus("bundled-9x9", seeds, options, measurements);
+
+        for (const auto* path : otherSizePaths)
+        {
+            ok = bench_file(path, options, measurements) && ok;
+        }
+    }
+
+    if (0 != options.Generated && !seeds.empty())
+    {
+        std::mt19937 generator(options.Seed);
+
+        std::vector<SudokuGrid> generated;
+        generated.reserve(options.Generated);
+        for (unsigned i = 0; i < options.Generated; ++i)
+        {
+            generated.push_back(shuffled_grid(seeds[i % seeds.size()], generator));
+        }
+
+        bench_corpus("generated-9x9", generated, options, measurements);
+    }
+
+    for (const auto& path : options.Corpora)
+    {
+        ok = bench_file(path, options, measurements) && ok;
+    }
+
+    if (nullptr != options.JsonPath)
+    {
+        ok = write_json(options.JsonPath, options, measurements) && ok;
+    }
+
+    return ok ? 0 : 1;
+}
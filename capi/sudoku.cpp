@@ -0,0 +1,126 @@
+#include "sudoku.h"
+
+#include "ConstrainSolver.h"
+#include "SudokuGrid.h"
+
+#include <new>
+
+struct sudoku_ctx
+{
+    ConstrainSolver Solver;
+    SudokuGrid Grid;
+};
+
+namespace
+{
+
+/// @return false if @p in has a cell which is neither a digit nor '.'.
+bool read_grid(const char* in, SudokuGrid& grid) noexcept
+{
+    auto* cells = &grid[0][0];
+    for (unsigned i = 0; i < SUDOKU_CELLS; ++i)
+    {
+        const auto c = in[i];
+        if ('.' == c)
+        {
+            cells[i] = 0;
+        }
+        else if ('0' <= c && c <= '9')
+        {
+            cells[i] = static_cast<char>(c - '0');
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void write_grid(const SudokuGrid& grid, char* out) noexcept
+{
+    const auto* cells = &grid[0][0];
+    for (unsigned i = 0; i < SUDOKU_CELLS; ++i)
+    {
+        out[i] = static_cast<char>('0' + cells[i]);
+    }
+}
+
+sudoku_status solve(const char* in, char* out, sudoku_ctx& ctx) noexcept
+{
+    if (!read_grid(in, ctx.Grid))
+        return SUDOKU_INVALID_GRID;
+
+    ctx.Solver.reset(ctx.Grid);
+    if (!ctx.Solver.exec())
+        return SUDOKU_UNSOLVABLE;
+
+    write_grid(ctx.Grid, out);
+    return SUDOKU_OK;
+}
+
+}
+
+int sudoku_abi_version(void)
+{
+    return SUDOKU_ABI_VERSION;
+}
+
+sudoku_ctx* sudoku_ctx_create(void)
+{
+    return new (std::nothrow) sudoku_ctx();
+}
+
+void sudoku_ctx_destroy(sudoku_ctx* ctx)
+{
+    delete ctx;
+}
+
+sudoku_status sudoku_solve(const char in[SUDOKU_CELLS], char out[SUDOKU_CELLS], sudoku_ctx* ctx)
+{
+    if (nullptr == in || nullptr == out || nullptr == ctx)
+        return SUDOKU_INVALID_ARGUMENT;
+
+    return solve(in, out, *ctx);
+}
+
+sudoku_status sudoku_solve_batch(const char* in, char* out, size_t count, sudoku_status* statuses, sudoku_ctx* ctx)
+{
+    if ((0 != count && (nullptr == in || nullptr == out)) || nullptr == ctx)
+        return SUDOKU_INVALID_ARGUMENT;
+
+    auto result = SUDOKU_OK;
+    for (size_t i = 0; i < count; ++i)
+    {
+        const auto status = solve(in + i * SUDOKU_CELLS, out + i * SUDOKU_CELLS, *ctx);
+        if (nullptr != statuses)
+        {
+            statuses[i] = status;
+        }
+
+        if (SUDOKU_OK == result)
+        {
+            result = status;
+        }
+    }
+
+    return result;
+}
+
+const char* sudoku_status_string(sudoku_status status)
+{
+    switch (status)
+    {
+    case SUDOKU_OK:
+        return "solved";
+    case SUDOKU_UNSOLVABLE:
+        return "the grid has no solution";
+    case SUDOKU_INVALID_ARGUMENT:
+        return "null pointer argument";
+    case SUDOKU_INVALID_GRID:
+        return "a cell is neither a digit nor '.'";
+    default:
+        return "unknown status";
+    }
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+/* A C interface to the 9x9 solvers, for callers which can't use the C++
+ * headers. It only depends on the C standard library, and its functions
+ * never throw, print nor allocate, besides sudoku_ctx_create(). */
+
+#include <stddef.h>
+
+#if defined(_WIN32)
+#  if defined(SUDOKU_BUILDING_LIBRARY)
+#    define SUDOKU_API __declspec(dllexport)
+#  else
+#    define SUDOKU_API __declspec(dllimport)
+#  endif
+#else
+#  define SUDOKU_API __attribute__((visibility("default")))
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// The version of this interface, which only changes if existing callers
+/// would break.
+#define SUDOKU_ABI_VERSION 1
+
+/// Number of cells of a grid.
+#define SUDOKU_CELLS 81
+
+/// What a function of this interface returned.
+typedef enum sudoku_status
+{
+    SUDOKU_OK = 0,
+
+    /// The grid has no solution, e.g. a given is repeated in a unit.
+    SUDOKU_UNSOLVABLE = 1,
+
+    /// A pointer argument is null.
+    SUDOKU_INVALID_ARGUMENT = -1,
+
+    /// A cell is neither a digit nor '.'.
+    SUDOKU_INVALID_GRID = -2
+} sudoku_status;
+
+/// The solving state, kept from one call to the next. A context must not
+/// be used by two threads at once: give each thread its own.
+typedef struct sudoku_ctx sudoku_ctx;
+
+/// @return SUDOKU_ABI_VERSION of the library, which may differ from the
+/// one of the header it was built with.
+SUDOKU_API int sudoku_abi_version(void);
+
+/// @return A new context, or NULL if out of memory.
+SUDOKU_API sudoku_ctx* sudoku_ctx_create(void);
+
+/// Destroy @p ctx, which may be NULL.
+SUDOKU_API void sudoku_ctx_destroy(sudoku_ctx* ctx);
+
+/// Solve a grid given row by row: the digits '1' to '9', and '0' or '.'
+/// for empty cells. No terminator is needed.
+///
+/// @param out Receives the solution, as '1' to '9', if SUDOKU_OK is
+///            returned, and is left as is otherwise. It may be @p in.
+/// @return SUDOKU_OK, SUDOKU_UNSOLVABLE or an error.
+SUDOKU_API sudoku_status sudoku_solve(const char in[SUDOKU_CELLS], char out[SUDOKU_CELLS], sudoku_ctx* ctx);
+
+/// Solve @p count grids laid out one after the other, as sudoku_solve()
+/// does for each of them.
+///
+/// @param statuses Receives the status of each grid, unless NULL.
+/// @return SUDOKU_OK if all the grids were solved, otherwise the status of
+///         the first one which wasn't.
+SUDOKU_API sudoku_status sudoku_solve_batch(const char* in, char* out, size_t count, sudoku_status* statuses, sudoku_ctx* ctx);
+
+/// @return A static description of @p status.
+SUDOKU_API const char* sudoku_status_string(sudoku_status status);
+
+#ifdef __cplusplus
+}
+#endif
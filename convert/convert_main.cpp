@@ -0,0 +1,214 @@
+// This file is the corpus converter entry point.
+//
+// Converts text corpora (see PuzzleReader) to packed ones (see
+// PackedCorpus) and back: the direction is told from the input file.
+// See print_usage() for the options.
+
+#include "BatchSolver.h"
+#include "ConstrainSolver.h"
+#include "PackedCorpus.h"
+#include "PuzzleReader.h"
+#include "SudokuGrid.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+struct Options
+{
+    bool Solutions = false;
+    bool Spaced = false;
+    const char* InputPath = nullptr;
+    const char* OutputPath = nullptr;
+};
+
+template <unsigned Side>
+bool pack(const Options& options)
+{
+    std::vector<BasicSudokuGrid<Side>> puzzles;
+    PuzzleReader reader(options.InputPath);
+    if (!reader.read_all(puzzles))
+    {
+        fprintf(stderr, "%s\n", reader.errorMessage().c_str());
+        return false;
+    }
+
+    std::vector<BasicSudokuGrid<Side>> solutions;
+    if (options.Solutions)
+    {
+        solutions = puzzles;
+        const auto results = BatchSolver().solve<BasicConstrainSolver<Side>>(solutions.data(), solutions.size());
+        const auto unsolved = std::find_if(results.cbegin(), results.cend(), [](const BatchResult& r) { return !r.Solved; });
+        if (unsolved != results.cend())
+        {
+            fprintf(stderr, "Grid %zu has no solution\n", static_cast<std::size_t>(unsolved - results.cbegin()) + 1);
+            return false;
+        }
+    }
+
+    PackedCorpusWriter writer(options.OutputPath, Side, options.Solutions);
+    for (std::size_t i = 0; i < puzzles.size() && !writer.failed(); ++i)
+    {
+        writer.write(puzzles[i], options.Solutions ? &solutions[i] : nullptr);
+    }
+
+    if (!writer.close())
+    {
+        fprintf(stderr, "%s\n", writer.errorMessage().c_str());
+        return false;
+    }
+
+    return true;
+}
+
+template <unsigned Side>
+bool unpack(const PackedCorpus& corpus, const Options& options)
+{
+    if (options.Solutions && !corpus.hasSolutions())
+    {
+        fprintf(stderr, "Packed corpus '%s' holds no solutions\n", options.InputPath);
+        return false;
+    }
+
+    auto* output = std::fopen(options.OutputPath, "w");
+    if (nullptr == output)
+    {
+        fprintf(stderr, "Cannot write '%s'\n", options.OutputPath);
+        return false;
+    }
+
+    BasicSudokuGrid<Side> grid;
+    std::string text;
+    bool ok = true;
+    std::size_t index = 0;
+    for (const auto record : corpus.records<Side>())
+    {
+        ++index;
+        if (!(options.Solutions ? record.solution() : record.puzzle()).unpack(grid))
+        {
+            fprintf(stderr, "Packed corpus '%s' has an invalid cell in record %zu\n", options.InputPath, index);
+            std::fclose(output);
+            return false;
+        }
+
+        format_grid(grid, options.Spaced, text);
+
+        // Written a block at a time.
+        if (text.size() >= (1U << 16U))
+        {
+            ok = ok && text.size() == std::fwrite(text.data(), 1, text.size(), output);
+            text.clear();
+        }
+    }
+
+    ok = ok && text.size() == std::fwrite(text.data(), 1, text.size(), output);
+    ok = 0 == std::fclose(output) && ok;
+    if (!ok)
+    {
+        fprintf(stderr, "Cannot write '%s'\n", options.OutputPath);
+    }
+
+    return ok;
+}
+
+bool unpack(const Options& options)
+{
+    const PackedCorpus corpus(options.InputPath);
+    if (corpus.failed())
+    {
+        fprintf(stderr, "%s\n", corpus.errorMessage().c_str());
+        return false;
+    }
+
+    switch (corpus.side())
+    {
+    case 4:
+        return unpack<4>(corpus, options);
+    case 9:
+        return unpack<9>(corpus, options);
+    case 16:
+        return unpack<16>(corpus, options);
+    default:
+        return unpack<25>(corpus, options);
+    }
+}
+
+bool pack(const Options& options)
+{
+    switch (detect_grid_side(options.InputPath))
+    {
+    case 4:
+        return pack<4>(options);
+    case 9:
+        return pack<9>(options);
+    case 16:
+        return pack<16>(options);
+    case 25:
+        return pack<25>(options);
+    default:
+        fprintf(stderr, "Cannot tell the grid size of '%s'\n", options.InputPath);
+        return false;
+    }
+}
+
+void print_usage(const char* program)
+{
+    fprintf(stderr,
+        "Usage: %s [options] input output\n"
+        "\n"
+        "Converts a text corpus to a packed one, or a packed corpus back to\n"
+        "text.\n"
+        "\n"
+        "Options:\n"
+        "  --solutions       to packed: solve the puzzles and store their\n"
+        "                    solutions; to text: write the stored solutions\n"
+        "  --spaced          to text: write one grid row per line\n",
+        program);
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+    Options options;
+
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    const auto* const program = argv[0];
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i]; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+
+        bool valid = true;
+        if ("--solutions" == arg)
+            options.Solutions = true;
+        else if ("--spaced" == arg)
+            options.Spaced = true;
+        else if (0 == arg.compare(0, 2, "--"))
+            valid = false;
+        else if (nullptr == options.InputPath)
+            options.InputPath = argv[i]; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        else if (nullptr == options.OutputPath)
+            options.OutputPath = argv[i]; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        else
+            valid = false;
+
+        if (!valid)
+        {
+            print_usage(program);
+            return 1;
+        }
+    }
+
+    if (nullptr == options.OutputPath)
+    {
+        print_usage(program);
+        return 1;
+    }
+
+    const auto ok = is_packed_corpus(options.InputPath) ? unpack(options) : pack(options);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,6 @@
+#pragma once
+
+template <unsigned Side>
+class BasicConstrainSolver;
+
+using ConstrainSolver = BasicConstrainSolver<9>;
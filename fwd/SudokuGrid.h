@@ -1,3 +1,6 @@
 #pragma once
 
-class SudokuGrid;
+template <unsigned Side>
+class BasicSudokuGrid;
+
+using SudokuGrid = BasicSudokuGrid<9>;
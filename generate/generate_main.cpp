@@ -0,0 +1,207 @@
+// This file is the puzzle generator entry point.
+//
+// Puzzles are written in the layouts PuzzleReader accepts, one block of
+// puzzles at a time, so that any number of them can be streamed to a file
+// or a pipe. See print_usage() for the options.
+
+#include "PuzzleGenerator.h"
+#include "PuzzleReader.h"
+#include "SudokuGrid.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+struct Options
+{
+    std::uint64_t Count = 1000;
+    std::uint64_t First = 0;
+    std::uint64_t Seed = 1;
+    unsigned Side = 9;
+    unsigned Threads = 0;
+    bool Solutions = false;
+    bool Spaced = false;
+    const char* OutputPath = nullptr;
+    GeneratorOptions Generator;
+};
+
+// Large enough to keep all the threads busy, small enough to start
+// writing soon.
+constexpr std::size_t BlockSize = 4096;
+
+template <unsigned Side>
+bool generate(const Options& options, std::FILE* output)
+{
+    const BasicPuzzleGenerator<Side> generator(options.Seed, options.Generator);
+
+    std::vector<BasicSudokuGrid<Side>> grids;
+    std::string text;
+    for (std::uint64_t done = 0; done < options.Count; )
+    {
+        const auto count = static_cast<std::size_t>(std::min<std::uint64_t>(options.Count - done, BlockSize));
+        const auto first = options.First + done;
+
+        grids.resize(count);
+        if (options.Solutions)
+        {
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                generator.fill_solution(first + i, grids[i]);
+            }
+        }
+        else
+        {
+            generator.generate_many(first, count, grids.data(), options.Threads);
+        }
+
+        text.clear();
+        for (const auto& grid : grids)
+        {
+            format_grid(grid, options.Spaced, text);
+        }
+
+        if (text.size() != std::fwrite(text.data(), 1, text.size(), output))
+        {
+            fprintf(stderr, "Cannot write the puzzles\n");
+            return false;
+        }
+
+        done += count;
+    }
+
+    return true;
+}
+
+void print_usage(const char* program)
+{
+    fprintf(stderr,
+        "Usage: %s [options]\n"
+        "\n"
+        "Writes random puzzles with a unique solution, one per line.\n"
+        "\n"
+        "Options:\n"
+        "  --count N         number of puzzles (default: 1000)\n"
+        "  --seed N          seed of the puzzles (default: 1)\n"
+        "  --first N         index of the first puzzle, to resume or split\n"
+        "                    a run (default: 0)\n"
+        "  --size N          grid side: 4, 9, 16 or 25 (default: 9)\n"
+        "  --symmetry NAME   none|rotational|mirror|diagonal (default: none)\n"
+        "  --clues N         stop removing clues at N (default: as few as\n"
+        "                    possible)\n"
+        "  --threads N       worker threads, 0 for one per core (default: 0)\n"
+        "  --solutions       write full grids instead of puzzles\n"
+        "  --spaced          write one grid row per line\n"
+        "  --output FILE     write to FILE instead of the standard output\n",
+        program);
+}
+
+template <typename T>
+bool parse_number(const char* text, T& value)
+{
+    // strtoull() would take a sign, or leading spaces, and negate the
+    // number.
+    if (!std::isdigit(static_cast<unsigned char>(*text)))
+        return false;
+
+    errno = 0;
+    char* end = nullptr;
+    const auto parsed = std::strtoull(text, &end, 10);
+    if ('\0' != *end || ERANGE == errno || parsed > std::numeric_limits<T>::max())
+        return false;
+
+    value = static_cast<T>(parsed);
+    return true;
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+    Options options;
+
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    const auto* const program = argv[0];
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i]; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        const auto hasValue = i + 1 < argc;
+
+        bool valid = true;
+        if ("--count" == arg && hasValue)
+            valid = parse_number(argv[++i], options.Count); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        else if ("--seed" == arg && hasValue)
+            valid = parse_number(argv[++i], options.Seed); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        else if ("--first" == arg && hasValue)
+            valid = parse_number(argv[++i], options.First); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        else if ("--size" == arg && hasValue)
+            valid = parse_number(argv[++i], options.Side); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        else if ("--symmetry" == arg && hasValue)
+            valid = parse_symmetry(argv[++i], options.Generator.Symmetry); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        else if ("--clues" == arg && hasValue)
+            valid = parse_number(argv[++i], options.Generator.TargetClues); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        else if ("--threads" == arg && hasValue)
+            valid = parse_number(argv[++i], options.Threads); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        else if ("--solutions" == arg)
+            options.Solutions = true;
+        else if ("--spaced" == arg)
+            options.Spaced = true;
+        else if ("--output" == arg && hasValue)
+            options.OutputPath = argv[++i]; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        else
+            valid = false;
+
+        if (!valid)
+        {
+            print_usage(program);
+            return 1;
+        }
+    }
+
+    auto* output = stdout;
+    if (nullptr != options.OutputPath)
+    {
+        output = std::fopen(options.OutputPath, "w");
+        if (nullptr == output)
+        {
+            fprintf(stderr, "Cannot write '%s'\n", options.OutputPath);
+            return 1;
+        }
+    }
+
+    bool ok = false;
+    switch (options.Side)
+    {
+    case 4:
+        ok = generate<4>(options, output);
+        break;
+    case 9:
+        ok = generate<9>(options, output);
+        break;
+    case 16:
+        ok = generate<16>(options, output);
+        break;
+    case 25:
+        ok = generate<25>(options, output);
+        break;
+    default:
+        print_usage(program);
+        break;
+    }
+
+    if (output != stdout)
+    {
+        ok = 0 == std::fclose(output) && ok;
+    }
+
+    return ok ? 0 : 1;
+}
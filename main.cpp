@@ -1,43 +1,77 @@
+#include "BacktrackingSolver.h"
+#include "BatchSolver.h"
 #include "ConstrainSolver.h"
+#include "DifficultyRater.h"
+#include "DlxSolver.h"
+#include "LockstepSolver.h"
+#include "PackedCorpus.h"
+#include "PuzzleReader.h"
 #include "SudokuGrid.h"
+#include "Technique.h"
 #include "Validator.h"
 
+#include <algorithm>
 #include <chrono>
 #include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
 
-bool print_validation_status(const SudokuGrid& grid)
+template <unsigned Side>
+bool print_validation_status(const BasicSudokuGrid<Side>& grid)
 {
-    Validator validator(grid);
+    BasicValidator<Side> validator(grid);
     const auto status = validator.validate();
     const auto output = status ? stdout : stderr;
     fprintf(output, "Validation [1: success, 0: failure]: %d.\n", status);
-    if (!status)
+    for (const auto& conflict : validator.conflicts())
     {
         fprintf(output,
             "Duplicates at (%u, %u) and (%u, %u)\n",
-            validator.firstDuplicate().Row,
-            validator.firstDuplicate().Column,
-            validator.secondDuplicate().Row,
-            validator.secondDuplicate().Column);
+            conflict.First.Row,
+            conflict.First.Column,
+            conflict.Second.Row,
+            conflict.Second.Column);
     }
 
     return status;
 }
 
-int main(int argc, char *argv[])
+template <unsigned Side>
+void print_statistics(const BasicSolver<Side>&)
+{ }
+
+template <unsigned Side>
+void print_statistics(const BasicConstrainSolver<Side>& solver)
 {
-    if (argc != 2)
+    printf("Applied %u deduction(s) with %u guess(es).\n", solver.iterations(), solver.branches());
+    for (unsigned i = 0; i < TechniqueCount; ++i)
     {
-        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
-        fprintf(stderr, "Usage: %s \"input file\"\n", argv[0]);
-        return 1;
+        const auto technique = static_cast<Technique>(i);
+        const auto& stats = solver.stats(technique);
+        if (0 != stats.Steps)
+        {
+            printf("  %-14s %lu step(s), %lu placement(s), %lu elimination(s)\n",
+                   technique_name(technique), stats.Steps, stats.Placements, stats.Eliminations);
+        }
     }
+}
 
-    SudokuGrid grid;
-    const auto readStatus = fill_from_input_file(argv[1], grid); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
-    if (!readStatus)
-        return 1;
+template <unsigned Side>
+void print_statistics(const BasicBacktrackingSolver<Side>& solver)
+{
+    printf("Visited %lu node(s) with %lu backtrack(s).\n", solver.nodes(), solver.backtracks());
+}
+
+template <unsigned Side>
+void print_statistics(const BasicDlxSolver<Side>& solver)
+{
+    printf("Visited %lu node(s).\n", solver.nodes());
+}
 
+template <typename SolverType, typename ... Args>
+int solve_grid(typename SolverType::grid_type& grid, const Args& ... args)
+{
     print_grid(grid);
 
     const auto inputValid = print_validation_status(grid);
@@ -45,8 +79,7 @@ int main(int argc, char *argv[])
         return 1;
 
     const auto start = std::chrono::steady_clock::now();
-    ConstrainSolver solver(grid);
-    //BacktrackingSolver solver(grid);
+    SolverType solver(grid, args...);
     solver.exec();
     const auto end = std::chrono::steady_clock::now();
 
@@ -57,6 +90,7 @@ int main(int argc, char *argv[])
     printf("Inserted %u (of %u) elements in %u iteration(s).\n",
            solver.insertedDigits(),
            solver.originalNumberOfMissingDigits(), 0);
+    print_statistics(solver);
 
     const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
     printf("Solution took %ld ms.\n", elapsed.count());
@@ -69,3 +103,196 @@ int main(int argc, char *argv[])
     print_validation_status(grid);
     return 0;
 }
+
+/// @param solveBatch Called as solveBatch(batchSolver, grids), returns the
+///                   BatchResult of each grid.
+template <typename Grid, typename SolveBatch>
+int solve_grids(std::vector<Grid>& grids, SolveBatch solveBatch)
+{
+    using validator_type = BasicValidator<Grid::sideLength()>;
+
+    for (std::size_t i = 0; i < grids.size(); ++i)
+    {
+        if (!validator_type(grids[i]).validate())
+        {
+            fprintf(stderr, "Grid %zu is not valid\n", i + 1);
+            return 1;
+        }
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    const BatchSolver batchSolver;
+    const auto results = solveBatch(batchSolver, grids);
+    const auto end = std::chrono::steady_clock::now();
+
+    const auto solved = std::count_if(results.cbegin(), results.cend(), [](const BatchResult& r) { return r.Solved; });
+    const auto valid = validator_type::validate_solutions(grids.data(), grids.size());
+
+    printf("Solved %ld of %zu grids on %u thread(s).\n", static_cast<long>(solved), grids.size(), batchSolver.threadCount());
+    printf("Validation: %zu of %zu grids are solved and valid.\n", valid, grids.size());
+
+    const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
+    printf("Solution took %ld ms.\n", elapsed.count());
+
+    return static_cast<std::size_t>(solved) == grids.size() ? 0 : 1;
+}
+
+template <typename SolverType, typename ... Args>
+int solve(std::vector<typename SolverType::grid_type>& grids, const Args& ... args)
+{
+    if (1 == grids.size())
+        return solve_grid<SolverType>(grids.front(), args...);
+
+    return solve_grids(grids, [&](const BatchSolver& batchSolver, std::vector<typename SolverType::grid_type>& batch)
+    {
+        return batchSolver.solve<SolverType>(batch.data(), batch.size(), args...);
+    });
+}
+
+int solve_lockstep(std::vector<SudokuGrid>& grids)
+{
+    const LockstepSolver solver;
+    printf("Lockstep solving with %s instructions.\n", instruction_set_name(solver.instructionSet()));
+
+    return solve_grids(grids, [&solver](const BatchSolver& batchSolver, std::vector<SudokuGrid>& batch)
+    {
+        return batchSolver.solve_chunks(solver, batch.data(), batch.size());
+    });
+}
+
+template <unsigned Side>
+int solve_lockstep(std::vector<BasicSudokuGrid<Side>>&)
+{
+    fprintf(stderr, "The lockstep solver only solves 9x9 grids\n");
+    return 1;
+}
+
+template <unsigned Side>
+int rate(const std::vector<BasicSudokuGrid<Side>>& grids, TechniqueSet techniques)
+{
+    const auto start = std::chrono::steady_clock::now();
+    const BasicDifficultyRater<Side> rater(techniques);
+    const auto ratings = rater.rate_many(grids.data(), grids.size());
+    const auto end = std::chrono::steady_clock::now();
+
+    if (1 == grids.size())
+    {
+        const auto& rating = ratings.front();
+        printf("Score %.1f: %u step(s), hardest technique %s.\n", rating.Score, rating.Steps, technique_name(rating.Hardest));
+        if (rating.NeedsSearch)
+        {
+            printf("The techniques got stuck: solving took %u guess(es).\n", rating.Guesses);
+        }
+    }
+    else
+    {
+        unsigned long hardest[TechniqueCount] = {};
+        unsigned long search = 0;
+        double totalScore = 0;
+        for (const auto& rating : ratings)
+        {
+            if (rating.NeedsSearch)
+            {
+                ++search;
+            }
+            else
+            {
+                ++hardest[static_cast<unsigned>(rating.Hardest)];
+            }
+
+            totalScore += rating.Score;
+        }
+
+        printf("Rated %zu grids, mean score %.2f.\n", grids.size(), totalScore / static_cast<double>(grids.size()));
+        for (unsigned i = 0; i < TechniqueCount; ++i)
+        {
+            if (0 != hardest[i])
+            {
+                printf("  %-14s %lu grid(s)\n", technique_name(static_cast<Technique>(i)), hardest[i]);
+            }
+        }
+
+        printf("  %-14s %lu grid(s)\n", "search", search);
+    }
+
+    const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
+    printf("Rating took %ld ms.\n", elapsed.count());
+
+    const auto solved = std::count_if(ratings.cbegin(), ratings.cend(), [](const DifficultyRating& r) { return r.Solved; });
+    return static_cast<std::size_t>(solved) == grids.size() ? 0 : 1;
+}
+
+template <unsigned Side>
+int run(const char* inputFile, const char* solverName, TechniqueSet techniques)
+{
+    std::vector<BasicSudokuGrid<Side>> grids;
+    std::string errorMessage;
+    if (!read_puzzles(inputFile, grids, errorMessage))
+    {
+        fprintf(stderr, "%s\n", errorMessage.c_str());
+        return 1;
+    }
+
+    if (grids.empty())
+    {
+        fprintf(stderr, "No grid in input file '%s'\n", inputFile);
+        return 1;
+    }
+
+    if (0 == strcmp(solverName, "constrain"))
+        return solve<BasicConstrainSolver<Side>>(grids, techniques);
+
+    if (0 == strcmp(solverName, "backtracking"))
+        return solve<BasicBacktrackingSolver<Side>>(grids);
+
+    if (0 == strcmp(solverName, "mrv"))
+        return solve<BasicMrvBacktrackingSolver<Side>>(grids);
+
+    if (0 == strcmp(solverName, "dlx"))
+        return solve<BasicDlxSolver<Side>>(grids);
+
+    if (0 == strcmp(solverName, "lockstep"))
+        return solve_lockstep(grids);
+
+    if (0 == strcmp(solverName, "rate"))
+        return rate(grids, techniques);
+
+    fprintf(stderr, "Unknown solver '%s'\n", solverName);
+    return 1;
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc < 2 || argc > 4)
+    {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        fprintf(stderr, "Usage: %s \"input file\" [constrain|backtracking|mrv|dlx|lockstep|rate] [techniques]\n", argv[0]);
+        return 1;
+    }
+
+    const auto* const inputFile = argv[1]; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    const auto* const solverName = argc >= 3 ? argv[2] : "constrain"; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+
+    auto techniques = TechniqueSet::all();
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    if (argc == 4 && !TechniqueSet::parse(argv[3], techniques))
+    {
+        fprintf(stderr, "Unknown technique in '%s'\n", argv[3]); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        return 1;
+    }
+
+    switch (detect_grid_side(inputFile))
+    {
+    case 4:
+        return run<4>(inputFile, solverName, techniques);
+    case 9:
+        return run<9>(inputFile, solverName, techniques);
+    case 16:
+        return run<16>(inputFile, solverName, techniques);
+    case 25:
+        return run<25>(inputFile, solverName, techniques);
+    default:
+        // Let the reader report a missing or malformed file.
+        return run<9>(inputFile, solverName, techniques);
+    }
+}
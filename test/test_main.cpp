@@ -4,8 +4,32 @@
 #include "doctest/doctest.h"
 
 #include "Matrix.h"
+#include "AllocationCounter.h"
+#include "BacktrackingSolver.h"
+#include "BatchSolver.h"
+#include "Canonicalizer.h"
 #include "ConstrainSolver.h"
+#include "DifficultyRater.h"
+#include "DigitMask.h"
+#include "DlxSolver.h"
+#include "GridLayout.h"
+#include "HintEngine.h"
+#include "IncrementalBoard.h"
+#include "LockstepSolver.h"
+#include "PackedCorpus.h"
+#include "PuzzleGenerator.h"
+#include "PuzzleReader.h"
+#include "SolutionCache.h"
+#include "TechniquePipeline.h"
 #include "Validator.h"
+#include "sudoku.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
 
 void solve_grid(const char* inputFileName)
 {
@@ -34,6 +58,52 @@ void solve_grid(const char* inputFileName)
     CHECK(solved);
 }
 
+template <typename SolverType, typename ... Args>
+void solve_grid_with(const char* inputFileName, Args ... args)
+{
+    using grid_type = typename SolverType::grid_type;
+
+    grid_type grid;
+    REQUIRE(fill_from_input_file(inputFileName, grid));
+
+    SolverType solver(grid, args...);
+    CHECK(solver.exec());
+    CHECK(solver.insertedDigits() == solver.originalNumberOfMissingDigits());
+    CHECK(BasicValidator<grid_type::sideLength()>(grid).validate());
+    CHECK(std::none_of(grid.cbegin(), grid.cend(), [](typename grid_type::value_type v) { return is_empty(v); }));
+}
+
+/// @brief Solve @p inputs twice with a single SolverType(args...), and
+/// check each answer against a SolverType built for the grid.
+template <typename SolverType, typename ... Args>
+void check_reused_solver(const std::vector<typename SolverType::grid_type>& inputs, Args ... args)
+{
+    using grid_type = typename SolverType::grid_type;
+
+    SolverType reused(args...);
+    const auto check_all = [&inputs, &args...](SolverType& solver)
+    {
+        for (const auto& input : inputs)
+        {
+            auto expected = input;
+            SolverType fresh(expected, args...);
+            const auto solved = fresh.exec();
+
+            grid_type solution;
+            CHECK(solver.solve(input, solution) == solved);
+            CHECK(std::equal(solution.cbegin(), solution.cend(), expected.cbegin()));
+            CHECK(solver.insertedDigits() == fresh.insertedDigits());
+            CHECK(solver.originalNumberOfMissingDigits() == fresh.originalNumberOfMissingDigits());
+        }
+    };
+
+    check_all(reused);
+
+    // A moved solver carries on with the same buffers.
+    auto moved = std::move(reused);
+    check_all(moved);
+}
+
 TEST_CASE("non-regression")
 {
     SUBCASE("solve easy grid")
@@ -57,3 +127,1809 @@ TEST_CASE("non-regression")
     }
 }
 
+
+TEST_CASE("constraint propagation")
+{
+    SUBCASE("only the units which change are propagated")
+    {
+        SudokuGrid grid;
+        REQUIRE(fill_from_input_file("../../data/evil_input.txt", grid));
+        REQUIRE(ConstrainSolver(grid).exec());
+
+        const auto solution = grid;
+        grid[4][4] = 0;
+        grid[4][5] = 0;
+
+        ConstrainSolver solver(grid);
+        CHECK(solver.exec());
+        CHECK(std::equal(grid.cbegin(), grid.cend(), solution.cbegin()));
+
+        // Two naked singles, and nothing else to do.
+        CHECK(solver.iterations() == 2);
+        CHECK(solver.stats(Technique::NakedSingle).Steps == 2);
+        CHECK(solver.stats(Technique::HiddenSingle).Steps == 0);
+    }
+
+    SUBCASE("rows and columns are alike")
+    {
+        SudokuGrid grid;
+        REQUIRE(fill_from_input_file("../../data/evil_input.txt", grid));
+
+        SudokuGrid transposed;
+        for (unsigned r = 0; r < SudokuGrid::rows(); ++r)
+        {
+            for (unsigned c = 0; c < SudokuGrid::columns(); ++c)
+            {
+                transposed[c][r] = grid[r][c];
+            }
+        }
+
+        ConstrainSolver solver(grid);
+        ConstrainSolver transposedSolver(transposed);
+        CHECK(solver.exec());
+        CHECK(transposedSolver.exec());
+        CHECK(solver.branches() == 0);
+        CHECK(transposedSolver.branches() == 0);
+        CHECK(Validator(transposed).validate());
+    }
+
+    SUBCASE("guess when propagation is stuck")
+    {
+        SudokuGrid evil;
+        REQUIRE(fill_from_input_file("../../data/evil_input.txt", evil));
+
+        SudokuGrid empty;
+        std::fill(empty.begin(), empty.end(), 0);
+
+        // Singles alone can't finish the evil grid.
+        const struct
+        {
+            SudokuGrid* Grid;
+            TechniqueSet Techniques;
+        } cases[] = {
+            { &evil, TechniqueSet::up_to(Technique::HiddenSingle) },
+            { &empty, TechniqueSet::all() }
+        };
+
+        for (const auto& c : cases)
+        {
+            ConstrainSolver solver(*c.Grid, c.Techniques);
+            CHECK(solver.exec());
+            CHECK(solver.branches() > 0);
+            CHECK(solver.insertedDigits() == solver.originalNumberOfMissingDigits());
+            CHECK(Validator(*c.Grid).validate());
+        }
+    }
+
+    SUBCASE("take changes back from the trail")
+    {
+        SudokuGrid grid;
+        REQUIRE(fill_from_input_file("../../data/evil_input.txt", grid));
+        const auto puzzle = grid;
+
+        CandidateBoard::Change trail[CandidateBoard::MaxChanges];
+        CandidateBoard board(grid);
+        const auto before = board.candidateGrid();
+        board.record(trail);
+
+        unsigned cell = 0;
+        while (!is_empty(board.value(cell)))
+        {
+            ++cell;
+        }
+
+        board.place(cell, board.candidates(cell).lowest());
+        board.eliminate(cell + 1, DigitMask::all());
+        CHECK(board.changes() > 1);
+
+        board.undo(0);
+        CHECK(0 == board.changes());
+        CHECK_FALSE(board.contradiction());
+        CHECK(std::equal(grid.cbegin(), grid.cend(), puzzle.cbegin()));
+        CHECK(std::equal(board.candidateGrid().cbegin(), board.candidateGrid().cend(), before.cbegin()));
+
+        // The per-digit view is back, too.
+        const CandidateBoard fresh(grid);
+        for (unsigned digit = 1; digit <= 9; ++digit)
+        {
+            for (unsigned unit = 0; unit < 27; ++unit)
+            {
+                CHECK(board.positions(digit, unit) == fresh.positions(digit, unit));
+                CHECK(board.placedDigits(unit) == fresh.placedDigits(unit));
+            }
+        }
+    }
+
+    SUBCASE("guess deep on large grids")
+    {
+        BasicSudokuGrid<25> grid;
+        std::fill(grid.begin(), grid.end(), 0);
+
+        BasicConstrainSolver<25> solver(grid);
+        CHECK(solver.exec());
+        CHECK(solver.branches() > 0);
+        CHECK(BasicValidator<25>::is_solution(grid));
+    }
+
+    SUBCASE("report unsolvable grids")
+    {
+        SudokuGrid grid;
+        REQUIRE(fill_from_input_file("../../data/evil_input.txt", grid));
+
+        // These givens don't break any rule, but leave no solution.
+        grid[0][0] = 0;
+        grid[0][1] = 6;
+        grid[0][2] = 8;
+        grid[0][3] = 1;
+
+        ConstrainSolver solver(grid);
+        CHECK_FALSE(solver.exec());
+
+        SudokuGrid conflicting;
+        REQUIRE(fill_from_input_file("../../data/evil_input.txt", conflicting));
+        conflicting[0][0] = 7;
+        CHECK_FALSE(ConstrainSolver(conflicting).exec());
+    }
+
+    SUBCASE("no heap allocations")
+    {
+        const char* inputFileNames[] = {
+            "../../data/easy_input.txt",
+            "../../data/medium_input.txt",
+            "../../data/hard_input.txt",
+            "../../data/evil_input.txt"
+        };
+
+        for (const auto* inputFileName : inputFileNames)
+        {
+            SudokuGrid grid;
+            REQUIRE(fill_from_input_file(inputFileName, grid));
+
+            const auto allocationsBefore = allocation_count();
+            const auto solved = ConstrainSolver(grid).exec();
+            const auto allocations = allocation_count() - allocationsBefore;
+
+            CHECK(solved);
+            CHECK(0 == allocations);
+        }
+
+        BasicSudokuGrid<25> largeGrid;
+        REQUIRE(fill_from_input_file("../../data/25x25_input.txt", largeGrid));
+
+        const auto allocationsBefore = allocation_count();
+        const auto solved = BasicConstrainSolver<25>(largeGrid).exec();
+        const auto allocations = allocation_count() - allocationsBefore;
+
+        CHECK(solved);
+        CHECK(0 == allocations);
+    }
+}
+
+TEST_CASE("solving techniques")
+{
+    SUBCASE("deductions agree with the solution")
+    {
+        std::vector<SudokuGrid> grids;
+        for (const auto* inputFileName : { "../../data/evil_input.txt", "../../data/techniques_input.txt" })
+        {
+            PuzzleReader reader(inputFileName);
+            REQUIRE(reader.read_all(grids));
+        }
+
+        TechniqueStats total[TechniqueCount];
+        for (auto& grid : grids)
+        {
+            auto solution = grid;
+            REQUIRE(ConstrainSolver(solution).exec());
+
+            CandidateBoard board(grid);
+            TechniquePipeline pipeline;
+            Deduction deduction;
+            while (pipeline.find(board, deduction))
+            {
+                REQUIRE_FALSE(deduction.Contradiction);
+                for (const auto cell : deduction.Cells)
+                {
+                    CHECK(deduction.Kind == Technique::NakedSingle ? 1 == board.candidates(cell).count() : !board.candidates(cell).empty());
+                }
+
+                if (deduction.placement())
+                {
+                    const auto cell = deduction.Cells[0];
+                    CHECK(deduction.Digits == DigitMask::single(solution[cell / 9][cell % 9]));
+                }
+
+                for (const auto& elimination : deduction.Eliminations)
+                {
+                    CHECK_FALSE(elimination.Digits.contains(solution[elimination.Cell / 9][elimination.Cell % 9]));
+                    CHECK(elimination.Digits.is_subset_of(board.candidates(elimination.Cell)));
+                }
+
+                board.apply(deduction);
+
+                // The positions of each digit follow the candidates.
+                for (unsigned unit = 0; unit < CandidateBoard::UnitCount; ++unit)
+                {
+                    DigitMask placed;
+                    for (unsigned digit = 1; digit <= 9; ++digit)
+                    {
+                        DigitMask positions;
+                        for (unsigned i = 0; i < 9; ++i)
+                        {
+                            const auto cell = CandidateBoard::unit_cell(unit, i);
+                            if (board.candidates(cell).contains(digit))
+                            {
+                                positions.insert(i + 1);
+                            }
+
+                            if (board.value(cell) == digit)
+                            {
+                                placed.insert(digit);
+                            }
+                        }
+
+                        CHECK(board.positions(digit, unit) == positions);
+                    }
+
+                    CHECK(board.placedDigits(unit) == placed);
+                }
+            }
+
+            CHECK_FALSE(board.contradiction());
+            for (unsigned i = 0; i < TechniqueCount; ++i)
+            {
+                total[i].Steps += pipeline.technique(static_cast<Technique>(i)).stats().Steps;
+            }
+        }
+
+        // A hidden quad comes with a naked subset of the other cells of the
+        // unit, which is found first.
+        for (unsigned i = 0; i < static_cast<unsigned>(Technique::HiddenQuad); ++i)
+        {
+            CAPTURE(technique_name(static_cast<Technique>(i)));
+            CHECK(total[i].Steps > 0);
+        }
+    }
+
+    SUBCASE("count what each technique did")
+    {
+        SudokuGrid grid;
+        REQUIRE(fill_from_input_file("../../data/evil_input.txt", grid));
+
+        auto techniques = TechniqueSet::all();
+        techniques.erase(Technique::HiddenQuad);
+
+        ConstrainSolver solver(grid, techniques);
+        REQUIRE(solver.exec());
+        CHECK(solver.techniques() == techniques);
+
+        unsigned long steps = 0;
+        unsigned long placements = 0;
+        for (unsigned i = 0; i < TechniqueCount; ++i)
+        {
+            const auto& stats = solver.stats(static_cast<Technique>(i));
+            CHECK(stats.Steps <= stats.Attempts);
+            steps += stats.Steps;
+            placements += stats.Placements;
+        }
+
+        CHECK(steps == solver.iterations());
+        CHECK(placements == solver.insertedDigits());
+        CHECK(solver.stats(Technique::Pointing).Eliminations > 0);
+        CHECK(solver.stats(Technique::Pointing).Placements == 0);
+
+        // Never asked, as it's disabled.
+        CHECK(solver.stats(Technique::HiddenQuad).Attempts == 0);
+    }
+
+    SUBCASE("select techniques by name")
+    {
+        TechniqueSet techniques;
+        REQUIRE(TechniqueSet::parse("naked-single,hidden-single", techniques));
+        CHECK(techniques == TechniqueSet::up_to(Technique::HiddenSingle));
+
+        REQUIRE(TechniqueSet::parse("all", techniques));
+        CHECK(techniques == TechniqueSet::all());
+
+        for (unsigned i = 0; i < TechniqueCount; ++i)
+        {
+            const auto technique = static_cast<Technique>(i);
+            REQUIRE(TechniqueSet::parse(technique_name(technique), techniques));
+            CHECK(techniques.contains(technique));
+        }
+
+        CHECK_FALSE(TechniqueSet::parse("naked-single,y-wing", techniques));
+        CHECK_FALSE(TechniqueSet::parse("", techniques));
+        CHECK(techniques.contains(Technique::HiddenQuad));
+    }
+}
+
+TEST_CASE("difficulty rating")
+{
+    std::vector<SudokuGrid> grids;
+    for (const auto* inputFileName : { "../../data/easy_input.txt", "../../data/evil_input.txt", "../../data/techniques_input.txt" })
+    {
+        PuzzleReader reader(inputFileName);
+        REQUIRE(reader.read_all(grids));
+    }
+
+    const DifficultyRater rater;
+
+    SUBCASE("hardest technique and score")
+    {
+        for (const auto& grid : grids)
+        {
+            const auto rating = rater.rate(grid);
+            CHECK(rating.Solved);
+
+            auto solved = grid;
+            ConstrainSolver solver(solved);
+            REQUIRE(solver.exec());
+            CHECK(rating.NeedsSearch == (0 != solver.branches()));
+
+            if (rating.NeedsSearch)
+            {
+                CHECK(rating.Score == SearchScore);
+                CHECK(rating.Guesses > 0);
+            }
+            else
+            {
+                CHECK(rating.Score == technique_score(rating.Hardest));
+                CHECK(rating.Steps == solver.iterations());
+                CHECK(0 != solver.stats(rating.Hardest).Steps);
+                CHECK(0 == rating.Guesses);
+            }
+        }
+
+        // The easy grid only needs singles.
+        const auto easy = rater.rate(grids.front());
+        CHECK_FALSE(easy.NeedsSearch);
+        CHECK(easy.Hardest <= Technique::HiddenSingle);
+    }
+
+    SUBCASE("fewer techniques, harder grids")
+    {
+        const DifficultyRater singles(TechniqueSet::up_to(Technique::HiddenSingle));
+        for (const auto& grid : grids)
+        {
+            const auto all = rater.rate(grid);
+            const auto rating = singles.rate(grid);
+            CHECK(rating.Solved);
+            CHECK(rating.Score >= all.Score);
+            CHECK(rating.Hardest <= Technique::HiddenSingle);
+            CHECK(rating.NeedsSearch == (all.NeedsSearch || all.Hardest > Technique::HiddenSingle));
+        }
+    }
+
+    SUBCASE("grids without a solution")
+    {
+        auto grid = grids.front();
+        const auto empty = std::find(grid.begin(), grid.end(), 0);
+        REQUIRE(empty != grid.end());
+
+        // The digit of the first clue in the same row.
+        const auto row = static_cast<unsigned>(empty - grid.begin()) / 9;
+        const auto clue = std::find_if(grid.row_begin(row), grid.row_end(row), [](char v) { return !is_empty(v); });
+        REQUIRE(clue != grid.row_end(row));
+        *empty = *clue;
+
+        CHECK_FALSE(rater.rate(grid).Solved);
+    }
+
+    SUBCASE("batch rating")
+    {
+        const auto ratings = rater.rate_many(grids.data(), grids.size(), 3);
+        REQUIRE(ratings.size() == grids.size());
+        for (std::size_t i = 0; i < grids.size(); ++i)
+        {
+            const auto rating = rater.rate(grids[i]);
+            CHECK(ratings[i].Score == rating.Score);
+            CHECK(ratings[i].Steps == rating.Steps);
+            CHECK(ratings[i].Hardest == rating.Hardest);
+        }
+    }
+}
+
+TEST_CASE("hints")
+{
+    SudokuGrid puzzle;
+    REQUIRE(fill_from_input_file("../../data/techniques_input.txt", puzzle));
+
+    auto solution = puzzle;
+    REQUIRE(ConstrainSolver(solution).exec());
+
+    const auto same_hint = [](const Deduction& lhs, const Deduction& rhs)
+    {
+        return lhs.Kind == rhs.Kind &&
+               lhs.Contradiction == rhs.Contradiction &&
+               lhs.Digits == rhs.Digits &&
+               lhs.Cells.size() == rhs.Cells.size() &&
+               std::equal(&lhs.Cells[0], &lhs.Cells[0] + lhs.Cells.size(), &rhs.Cells[0]) &&
+               lhs.Eliminations.size() == rhs.Eliminations.size();
+    };
+
+    HintEngine engine;
+    Deduction hint;
+    CHECK_FALSE(engine.next(hint));
+
+    SUBCASE("apply every hint")
+    {
+        // The same steps as the pipeline on its own.
+        auto expectedGrid = puzzle;
+        BasicCandidateBoard<9> board(expectedGrid);
+        TechniquePipeline pipeline;
+        Deduction expected;
+
+        engine.update(puzzle);
+        unsigned steps = 0;
+        while (engine.next(hint))
+        {
+            REQUIRE(pipeline.find(board, expected));
+            CHECK(same_hint(hint, expected));
+
+            Deduction again;
+            REQUIRE(engine.next(again));
+            CHECK(same_hint(hint, again));
+
+            board.apply(expected);
+            engine.apply(hint);
+            ++steps;
+        }
+
+        CHECK_FALSE(pipeline.find(board, expected));
+        CHECK(0 != steps);
+        CHECK(std::equal(engine.grid().cbegin(), engine.grid().cend(), expectedGrid.cbegin()));
+    }
+
+    SUBCASE("follow the player")
+    {
+        std::vector<unsigned> empties;
+        for (unsigned cell = 0; cell < 81; ++cell)
+        {
+            if (is_empty(puzzle[cell / 9][cell % 9]))
+            {
+                empties.push_back(cell);
+            }
+        }
+
+        std::mt19937 random(7);
+        std::shuffle(empties.begin(), empties.end(), random);
+
+        // The player fills the solution in at random, a few cells at a
+        // time: the engine gives the same hints as one started afresh.
+        auto grid = puzzle;
+        for (std::size_t i = 0; i < empties.size(); ++i)
+        {
+            const auto cell = empties[i];
+            grid[cell / 9][cell % 9] = solution[cell / 9][cell % 9];
+            if (0 != i % 3)
+                continue;
+
+            HintEngine fresh;
+            Deduction expected;
+            const auto found = fresh.next(grid, expected);
+            CHECK(engine.next(grid, hint) == found);
+            if (found)
+            {
+                CHECK(same_hint(hint, expected));
+            }
+        }
+
+        // Erasing a digit starts over.
+        const auto cell = empties.front();
+        grid[cell / 9][cell % 9] = 0;
+        REQUIRE(engine.next(grid, hint));
+        CHECK(hint.placement());
+        CHECK(hint.Cells[0] == cell);
+        CHECK(hint.Digits.lowest() == static_cast<unsigned>(solution[cell / 9][cell % 9]));
+    }
+
+    SUBCASE("no hint")
+    {
+        CHECK_FALSE(engine.next(solution, hint));
+
+        // Two equal digits in the first row.
+        auto conflicting = puzzle;
+        unsigned given = 0;
+        while (is_empty(conflicting[0][given]))
+        {
+            ++given;
+        }
+
+        unsigned empty = 0;
+        while (!is_empty(conflicting[0][empty]))
+        {
+            ++empty;
+        }
+
+        conflicting[0][empty] = conflicting[0][given];
+        CHECK_FALSE(engine.next(conflicting, hint));
+    }
+}
+
+TEST_CASE("incremental board")
+{
+    SudokuGrid puzzle;
+    REQUIRE(fill_from_input_file("../../data/easy_input.txt", puzzle));
+
+    auto solution = puzzle;
+    REQUIRE(ConstrainSolver(solution).exec());
+
+    IncrementalBoard board(puzzle);
+
+    // The candidates, blocked cells and conflicts a board built for the
+    // current grid would have.
+    const auto check_against_rebuilt = [](const IncrementalBoard& board)
+    {
+        auto grid = board.grid();
+        const BasicCandidateBoard<9> candidates(grid);
+        const auto validGrid = Validator(board.grid()).validate();
+        unsigned blocked = 0;
+        for (unsigned cell = 0; cell < 81; ++cell)
+        {
+            const auto row = cell / 9;
+            const auto column = cell % 9;
+            if (is_empty(grid[row][column]))
+            {
+                // The board builds the candidates only when the givens are
+                // consistent.
+                if (validGrid)
+                {
+                    CHECK(board.candidates(row, column) == candidates.candidates(cell));
+                }
+
+                blocked += board.candidates(row, column).empty();
+            }
+            else
+            {
+                CHECK(board.candidates(row, column).empty());
+            }
+        }
+
+        CHECK(board.blockedCells() == blocked);
+        CHECK((0 == board.conflicts()) == validGrid);
+    };
+
+    SUBCASE("givens")
+    {
+        CHECK(0 == board.moves());
+        CHECK(board.filledCells() == 81 - std::count(puzzle.begin(), puzzle.end(), 0));
+        CHECK(0 == board.conflicts());
+        check_against_rebuilt(board);
+
+        const auto given = std::find_if(puzzle.begin(), puzzle.end(), [](char value) { return !is_empty(value); }) - puzzle.begin();
+        CHECK(board.isGiven(given / 9, given % 9));
+        CHECK_FALSE(board.place(given / 9, given % 9, 1));
+        CHECK_FALSE(board.erase(given / 9, given % 9));
+        CHECK(0 == board.moves());
+    }
+
+    SUBCASE("play to the end and back")
+    {
+        std::vector<unsigned> empties;
+        for (unsigned cell = 0; cell < 81; ++cell)
+        {
+            if (is_empty(puzzle[cell / 9][cell % 9]))
+            {
+                empties.push_back(cell);
+            }
+        }
+
+        for (const auto cell : empties)
+        {
+            CHECK(board.candidates(cell / 9, cell % 9).contains(static_cast<unsigned>(solution[cell / 9][cell % 9])));
+            REQUIRE(board.place(cell / 9, cell % 9, static_cast<unsigned>(solution[cell / 9][cell % 9])));
+            CHECK_FALSE(board.isConflicting(cell / 9, cell % 9));
+        }
+
+        CHECK(board.solved());
+        CHECK(board.moves() == empties.size());
+        CHECK(0 == board.blockedCells());
+
+        while (board.undo())
+        { }
+
+        CHECK(0 == board.moves());
+        CHECK(std::equal(board.grid().cbegin(), board.grid().cend(), puzzle.cbegin()));
+        check_against_rebuilt(board);
+    }
+
+    SUBCASE("conflicts")
+    {
+        // A digit placed twice in the first row.
+        unsigned given = 0;
+        while (given < 9 && is_empty(puzzle[0][given]))
+        {
+            ++given;
+        }
+
+        unsigned empty = 0;
+        while (empty < 9 && !is_empty(puzzle[0][empty]))
+        {
+            ++empty;
+        }
+
+        REQUIRE((given < 9 && empty < 9));
+
+        const auto digit = static_cast<unsigned>(puzzle[0][given]);
+        REQUIRE(board.place(0, empty, digit));
+        CHECK(board.conflicts() >= 1);
+        CHECK(board.isConflicting(0, empty));
+        CHECK(board.isConflicting(0, given));
+        check_against_rebuilt(board);
+
+        // Replacing the digit is one more move.
+        const auto other = digit % 9 + 1;
+        REQUIRE(board.place(0, empty, other));
+        CHECK(2 == board.moves());
+        CHECK_FALSE(board.place(0, empty, other));
+        CHECK_FALSE(board.place(0, empty, 0));
+        CHECK_FALSE(board.place(0, empty, 10));
+        check_against_rebuilt(board);
+
+        REQUIRE(board.erase(0, empty));
+        CHECK_FALSE(board.erase(0, empty));
+        CHECK(0 == board.conflicts());
+        check_against_rebuilt(board);
+
+        REQUIRE(board.undo());
+        CHECK(other == static_cast<unsigned>(board.value(0, empty)));
+        REQUIRE(board.undo());
+        CHECK(board.isConflicting(0, empty));
+        REQUIRE(board.undo());
+        CHECK(0 == board.conflicts());
+        CHECK_FALSE(board.undo());
+        check_against_rebuilt(board);
+    }
+
+    SUBCASE("reset")
+    {
+        const auto empty = std::find(puzzle.begin(), puzzle.end(), 0) - puzzle.begin();
+        REQUIRE(board.place(empty / 9, empty % 9, 1));
+        board.reset(solution);
+        CHECK(0 == board.moves());
+        CHECK(board.solved());
+        CHECK(81 == board.filledCells());
+    }
+}
+
+TEST_CASE("validator")
+{
+    SudokuGrid grid;
+    REQUIRE(fill_from_input_file("../../data/evil_input.txt", grid));
+    REQUIRE(Validator(grid).validate());
+    CHECK_FALSE(Validator::is_solution(grid));
+
+    SUBCASE("report no duplicate without conflicts")
+    {
+        Validator validator(grid);
+        CHECK(0 == validator.firstDuplicate().Row);
+        REQUIRE(validator.validate());
+        CHECK(validator.conflicts().empty());
+        CHECK(0 == validator.firstDuplicate().Row);
+        CHECK(0 == validator.secondDuplicate().Column);
+    }
+
+    SUBCASE("report every conflict")
+    {
+        auto conflicting = grid;
+
+        // (0, 0) and (2, 2) share only the subgrid.
+        conflicting[0][0] = 9;
+        conflicting[2][2] = 9;
+        conflicting[2][0] = 0;
+        conflicting[0][2] = 0;
+
+        // (8, 7) shares a row with (8, 8), and a column and a subgrid with
+        // (7, 7): the latter pair is reported once.
+        conflicting[8][7] = 7;
+        conflicting[8][8] = 7;
+        conflicting[7][7] = 7;
+
+        Validator validator(conflicting);
+        REQUIRE_FALSE(validator.validate());
+        for (const auto& conflict : validator.conflicts())
+        {
+            CHECK(conflicting[conflict.First.Row][conflict.First.Column] == conflicting[conflict.Second.Row][conflict.Second.Column]);
+        }
+
+        const auto& conflicts = validator.conflicts();
+        const auto has_conflict = [&conflicts](unsigned r1, unsigned c1, unsigned r2, unsigned c2)
+        {
+            return std::any_of(conflicts.cbegin(), conflicts.cend(), [=](const Validator::Conflict& conflict)
+            {
+                return conflict.First.Row == r1 && conflict.First.Column == c1 &&
+                       conflict.Second.Row == r2 && conflict.Second.Column == c2;
+            });
+        };
+
+        CHECK(has_conflict(0, 0, 2, 2));
+        CHECK(has_conflict(8, 7, 8, 8));
+        CHECK(has_conflict(7, 7, 8, 7));
+        CHECK(1 == std::count_if(conflicts.cbegin(), conflicts.cend(), [](const Validator::Conflict& conflict)
+        {
+            return conflict.First.Row == 7 && conflict.First.Column == 7 &&
+                   conflict.Second.Row == 8 && conflict.Second.Column == 7;
+        }));
+        CHECK(validator.firstDuplicate().Row == validator.conflicts().front().First.Row);
+    }
+
+    SUBCASE("check solutions in batches")
+    {
+        std::vector<SudokuGrid> grids(3, grid);
+        REQUIRE(ConstrainSolver(grids[0]).exec());
+        REQUIRE(ConstrainSolver(grids[2]).exec());
+        CHECK(Validator::is_solution(grids[0]));
+
+        // A complete grid with a swap in a row breaks columns and subgrids.
+        std::swap(grids[2][4][0], grids[2][4][8]);
+
+        bool results[3] = {};
+        CHECK(1 == Validator::validate_solutions(grids.data(), grids.size(), results));
+        CHECK(results[0]);
+        CHECK_FALSE(results[1]);
+        CHECK_FALSE(results[2]);
+    }
+}
+
+TEST_CASE("solution counting")
+{
+    SudokuGrid grid;
+    REQUIRE(fill_from_input_file("../../data/evil_input.txt", grid));
+    const auto original = grid;
+
+    SUBCASE("unique solution")
+    {
+        CHECK(1 == count_solutions(grid, 2));
+        CHECK(1 == count_solutions(grid, 1));
+        CHECK(std::equal(grid.cbegin(), grid.cend(), original.cbegin()));
+    }
+
+    SUBCASE("several solutions")
+    {
+        SudokuGrid empty;
+        std::fill(empty.begin(), empty.end(), 0);
+        CHECK(2 == count_solutions(empty, 2));
+        CHECK(100 == count_solutions(empty, 100));
+
+        // Blanking a rectangle of cells holding a, b in one row and b, a in
+        // the other one, within two subgrids, leaves two solutions.
+        SudokuGrid solved = grid;
+        REQUIRE(ConstrainSolver(solved).exec());
+
+        bool found = false;
+        unsigned r1 = 0, r2 = 0, c1 = 0, c2 = 0;
+        for (unsigned i = 0; i < 9 * 9 * 9 * 9 && !found; ++i)
+        {
+            r1 = i % 9;
+            r2 = i / 9 % 9;
+            c1 = i / 81 % 9;
+            c2 = i / 729;
+            found = r1 < r2 && c1 < c2 &&
+                    (r1 / 3 == r2 / 3 || c1 / 3 == c2 / 3) &&
+                    solved[r1][c1] == solved[r2][c2] && solved[r1][c2] == solved[r2][c1];
+        }
+        REQUIRE(found);
+
+        solved[r1][c1] = 0;
+        solved[r1][c2] = 0;
+        solved[r2][c1] = 0;
+        solved[r2][c2] = 0;
+        CHECK(2 == count_solutions(solved, 10));
+    }
+
+    SUBCASE("no solution")
+    {
+        // These givens don't break any rule, but leave no solution.
+        grid[0][0] = 0;
+        grid[0][1] = 6;
+        grid[0][2] = 8;
+        grid[0][3] = 1;
+        CHECK(0 == count_solutions(grid, 2));
+
+        grid[0][3] = 6;
+        CHECK(0 == count_solutions(grid, 2));
+    }
+}
+
+TEST_CASE("canonical form")
+{
+    std::vector<SudokuGrid> grids;
+    for (const auto* inputFileName : { "../../data/easy_input.txt", "../../data/hard_input.txt", "../../data/evil_input.txt", "../../data/techniques_input.txt" })
+    {
+        PuzzleReader reader(inputFileName);
+        REQUIRE(reader.read_all(grids));
+    }
+
+    std::mt19937 generator(3);
+    const auto random_transform = [&generator]()
+    {
+        GridTransform transform;
+        transform.Transposed = 0 != generator() % 2;
+
+        unsigned bands[3] = { 0, 1, 2 };
+        unsigned stacks[3] = { 0, 1, 2 };
+        std::shuffle(bands, bands + 3, generator);
+        std::shuffle(stacks, stacks + 3, generator);
+        for (unsigned b = 0; b < 3; ++b)
+        {
+            unsigned rows[3] = { 0, 1, 2 };
+            unsigned columns[3] = { 0, 1, 2 };
+            std::shuffle(rows, rows + 3, generator);
+            std::shuffle(columns, columns + 3, generator);
+            for (unsigned i = 0; i < 3; ++i)
+            {
+                transform.Rows[3 * b + i] = static_cast<std::uint8_t>(3 * bands[b] + rows[i]);
+                transform.Columns[3 * b + i] = static_cast<std::uint8_t>(3 * stacks[b] + columns[i]);
+            }
+        }
+
+        std::shuffle(transform.Digits + 1, transform.Digits + 10, generator);
+        return transform;
+    };
+
+    Canonicalizer canonicalizer;
+
+    SUBCASE("same form for equivalent grids")
+    {
+        std::vector<std::uint64_t> hashes;
+        for (const auto& grid : grids)
+        {
+            SudokuGrid canonical;
+            const auto transform = canonicalizer.canonicalize(grid, canonical);
+            CHECK(Validator(canonical).validate());
+            CHECK(std::count(canonical.cbegin(), canonical.cend(), 0) == std::count(grid.cbegin(), grid.cend(), 0));
+
+            SudokuGrid back;
+            transform.apply_inverse(canonical, back);
+            CHECK(std::equal(back.cbegin(), back.cend(), grid.cbegin()));
+
+            for (int i = 0; i < 8; ++i)
+            {
+                SudokuGrid shuffled;
+                random_transform().apply(grid, shuffled);
+
+                SudokuGrid other;
+                canonicalizer.canonicalize(shuffled, other);
+                CHECK(std::equal(other.cbegin(), other.cend(), canonical.cbegin()));
+            }
+
+            hashes.push_back(grid_hash(canonical));
+        }
+
+        // The grids are all different.
+        std::sort(hashes.begin(), hashes.end());
+        CHECK(std::unique(hashes.begin(), hashes.end()) == hashes.end());
+    }
+
+    SUBCASE("least recently used entries go first")
+    {
+        SolutionCache cache(2);
+        SudokuGrid canonical[3];
+        for (unsigned i = 0; i < 3; ++i)
+        {
+            canonicalizer.canonicalize(grids[i], canonical[i]);
+        }
+
+        SudokuGrid solution;
+        cache.insert(canonical[0], grids[0]);
+        cache.insert(canonical[1], grids[1]);
+        REQUIRE(cache.find(canonical[0], solution));
+        CHECK(std::equal(solution.cbegin(), solution.cend(), grids[0].cbegin()));
+
+        cache.insert(canonical[2], grids[2]);
+        CHECK(2 == cache.size());
+        CHECK(cache.find(canonical[0], solution));
+        CHECK_FALSE(cache.find(canonical[1], solution));
+        CHECK(cache.find(canonical[2], solution));
+        CHECK(3 == cache.hits());
+        CHECK(1 == cache.misses());
+    }
+
+    SUBCASE("solve equivalent grids from the cache")
+    {
+        SolutionCache cache(64);
+        for (const auto& grid : grids)
+        {
+            auto solved = grid;
+            CachedSolver<ConstrainSolver> solver(solved, cache);
+            REQUIRE(solver.exec());
+            CHECK_FALSE(solver.cacheHit());
+
+            for (int i = 0; i < 4; ++i)
+            {
+                SudokuGrid shuffled;
+                random_transform().apply(grid, shuffled);
+
+                auto expected = shuffled;
+                REQUIRE(ConstrainSolver(expected).exec());
+
+                CachedSolver<ConstrainSolver> cached(shuffled, cache);
+                CHECK(cached.exec());
+                CHECK(cached.cacheHit());
+                CHECK(cached.insertedDigits() == cached.originalNumberOfMissingDigits());
+                CHECK(std::equal(shuffled.cbegin(), shuffled.cend(), expected.cbegin()));
+            }
+        }
+
+        CHECK(grids.size() == cache.size());
+    }
+}
+
+TEST_CASE("puzzle generator")
+{
+    SUBCASE("same seed, same puzzles")
+    {
+        const PuzzleGenerator generator(42);
+        std::vector<SudokuGrid> oneThread(12);
+        std::vector<SudokuGrid> threeThreads(12);
+        generator.generate_many(100, oneThread.size(), oneThread.data(), 1);
+        generator.generate_many(100, threeThreads.size(), threeThreads.data(), 3);
+
+        for (std::size_t i = 0; i < oneThread.size(); ++i)
+        {
+            CHECK(std::equal(oneThread[i].cbegin(), oneThread[i].cend(), threeThreads[i].cbegin()));
+
+            SudokuGrid puzzle;
+            generator.generate(100 + i, puzzle);
+            CHECK(std::equal(puzzle.cbegin(), puzzle.cend(), oneThread[i].cbegin()));
+        }
+
+        SudokuGrid first;
+        SudokuGrid other;
+        PuzzleGenerator(43).generate(100, other);
+        generator.generate(100, first);
+        CHECK_FALSE(std::equal(first.cbegin(), first.cend(), other.cbegin()));
+    }
+
+    SUBCASE("unique solutions")
+    {
+        const PuzzleGenerator generator(7);
+        for (std::uint64_t index = 0; index < 8; ++index)
+        {
+            SudokuGrid puzzle;
+            const auto clues = generator.generate(index, puzzle);
+            CHECK(clues == 81 - std::count(puzzle.cbegin(), puzzle.cend(), 0));
+            CHECK(1 == count_solutions(puzzle, 2));
+
+            // No clue can go.
+            for (auto& value : puzzle)
+            {
+                if (!is_empty(value))
+                {
+                    const auto saved = value;
+                    value = 0;
+                    CHECK(count_solutions(puzzle, 2) > 1);
+                    value = saved;
+                }
+            }
+
+            SudokuGrid solution;
+            generator.fill_solution(index, solution);
+            CHECK(Validator(solution).validate());
+            CHECK(0 == std::count(solution.cbegin(), solution.cend(), 0));
+
+            REQUIRE(ConstrainSolver(puzzle).exec());
+            CHECK(std::equal(puzzle.cbegin(), puzzle.cend(), solution.cbegin()));
+        }
+    }
+
+    SUBCASE("symmetry and clue count")
+    {
+        GeneratorOptions options;
+        options.Symmetry = ClueSymmetry::Rotational;
+        options.TargetClues = 36;
+
+        const PuzzleGenerator generator(3, options);
+        for (std::uint64_t index = 0; index < 8; ++index)
+        {
+            SudokuGrid puzzle;
+            const auto clues = generator.generate(index, puzzle);
+            CHECK(clues >= 36);
+            CHECK(clues <= 37);
+            CHECK(1 == count_solutions(puzzle, 2));
+
+            for (unsigned cell = 0; cell < 81; ++cell)
+            {
+                CHECK(is_empty(puzzle[cell / 9][cell % 9]) == is_empty(puzzle[8 - cell / 9][8 - cell % 9]));
+            }
+        }
+
+        ClueSymmetry symmetry = ClueSymmetry::None;
+        REQUIRE(parse_symmetry("mirror", symmetry));
+        CHECK(symmetry == ClueSymmetry::Mirror);
+        CHECK(0 == std::strcmp(symmetry_name(ClueSymmetry::Diagonal), "diagonal"));
+        CHECK_FALSE(parse_symmetry("spiral", symmetry));
+        CHECK(symmetry == ClueSymmetry::Mirror);
+    }
+
+    SUBCASE("other grid sizes")
+    {
+        BasicSudokuGrid<4> small;
+        BasicPuzzleGenerator<4>(1).generate(0, small);
+        CHECK(1 == count_solutions(small, 2));
+
+        BasicSudokuGrid<16> large;
+        BasicPuzzleGenerator<16>(1).generate(0, large);
+        CHECK(std::count(large.cbegin(), large.cend(), 0) > 0);
+        CHECK(BasicConstrainSolver<16>(large).exec());
+        CHECK(BasicValidator<16>(large).validate());
+    }
+}
+
+TEST_CASE("alternative solvers")
+{
+    const char* inputFileNames[] = {
+        "../../data/easy_input.txt",
+        "../../data/medium_input.txt",
+        "../../data/hard_input.txt",
+        "../../data/evil_input.txt"
+    };
+
+    SUBCASE("backtracking")
+    {
+        for (const auto* inputFileName : inputFileNames)
+        {
+            solve_grid_with<BacktrackingSolver>(inputFileName);
+        }
+    }
+
+    SUBCASE("minimum remaining values backtracking")
+    {
+        for (const auto* inputFileName : inputFileNames)
+        {
+            solve_grid_with<BacktrackingSolver>(inputFileName, BacktrackingSolver::Strategy::MinimumRemainingValues);
+        }
+    }
+
+    SUBCASE("minimum remaining values visits fewer nodes")
+    {
+        SudokuGrid rowMajorGrid;
+        REQUIRE(fill_from_input_file("../../data/evil_input.txt", rowMajorGrid));
+        auto mrvGrid = rowMajorGrid;
+
+        BacktrackingSolver rowMajor(rowMajorGrid);
+        BacktrackingSolver mrv(mrvGrid, BacktrackingSolver::Strategy::MinimumRemainingValues);
+        REQUIRE(rowMajor.exec());
+        REQUIRE(mrv.exec());
+
+        CHECK(std::equal(rowMajorGrid.cbegin(), rowMajorGrid.cend(), mrvGrid.cbegin()));
+        CHECK(mrv.nodes() < rowMajor.nodes());
+        CHECK(mrv.backtracks() < rowMajor.backtracks());
+        CHECK(mrv.nodes() - mrv.backtracks() == mrv.originalNumberOfMissingDigits());
+    }
+
+    SUBCASE("dancing links")
+    {
+        for (const auto* inputFileName : inputFileNames)
+        {
+            solve_grid_with<DlxSolver>(inputFileName);
+        }
+    }
+
+    SUBCASE("dancing links detects unsolvable grids")
+    {
+        SudokuGrid grid;
+        REQUIRE(fill_from_input_file("../../data/evil_input.txt", grid));
+
+        // These givens don't break any rule, but leave no solution.
+        grid[0][0] = 0;
+        grid[0][1] = 6;
+        grid[0][2] = 8;
+        grid[0][3] = 1;
+        const auto original = grid;
+
+        DlxSolver solver(grid);
+        CHECK_FALSE(solver.exec());
+        CHECK(std::equal(grid.cbegin(), grid.cend(), original.cbegin()));
+
+        // The node pool is restored: solving again gives the same answer.
+        CHECK_FALSE(solver.exec());
+    }
+
+    SUBCASE("dancing links rejects conflicting givens")
+    {
+        SudokuGrid grid;
+        REQUIRE(fill_from_input_file("../../data/evil_input.txt", grid));
+        grid[0][0] = 7;
+
+        DlxSolver solver(grid);
+        CHECK_FALSE(solver.exec());
+    }
+}
+
+TEST_CASE("grid sizes")
+{
+    SUBCASE("4x4")
+    {
+        REQUIRE(4 == detect_grid_side("../../data/4x4_input.txt"));
+        solve_grid_with<BasicConstrainSolver<4>>("../../data/4x4_input.txt");
+        solve_grid_with<BasicBacktrackingSolver<4>>("../../data/4x4_input.txt");
+        solve_grid_with<BasicDlxSolver<4>>("../../data/4x4_input.txt");
+    }
+
+    SUBCASE("16x16")
+    {
+        REQUIRE(16 == detect_grid_side("../../data/16x16_input.txt"));
+        solve_grid_with<BasicConstrainSolver<16>>("../../data/16x16_input.txt");
+        solve_grid_with<BasicBacktrackingSolver<16>>("../../data/16x16_input.txt", BasicBacktrackingSolver<16>::Strategy::MinimumRemainingValues);
+        solve_grid_with<BasicDlxSolver<16>>("../../data/16x16_input.txt");
+    }
+
+    SUBCASE("25x25")
+    {
+        REQUIRE(25 == detect_grid_side("../../data/25x25_input.txt"));
+        solve_grid_with<BasicConstrainSolver<25>>("../../data/25x25_input.txt");
+        solve_grid_with<BasicBacktrackingSolver<25>>("../../data/25x25_input.txt", BasicBacktrackingSolver<25>::Strategy::MinimumRemainingValues);
+        solve_grid_with<BasicDlxSolver<25>>("../../data/25x25_input.txt");
+    }
+
+    SUBCASE("9x9")
+    {
+        CHECK(9 == detect_grid_side("../../data/easy_input.txt"));
+    }
+
+    SUBCASE("symbols")
+    {
+        for (char value = 0; value <= 25; ++value)
+        {
+            CHECK(value == from_symbol(to_symbol(value)));
+        }
+
+        CHECK(16 == from_symbol('g'));
+        CHECK(0 == from_symbol('.'));
+        CHECK(-1 == from_symbol('#'));
+    }
+}
+
+namespace
+{
+
+template <unsigned Side>
+void check_grid_layout()
+{
+    using layout_type = BasicGridLayout<Side>;
+    constexpr auto subgridSide = layout_type::SubgridSide;
+
+    for (unsigned cell = 0; cell < Side * Side; ++cell)
+    {
+        const auto row = cell / Side;
+        const auto column = cell % Side;
+        const auto subgrid = subgridSide * (row / subgridSide) + column / subgridSide;
+
+        CHECK(row == layout_type::row_unit(cell));
+        CHECK(Side + column == layout_type::column_unit(cell));
+        CHECK(2 * Side + subgrid == layout_type::subgrid_unit(cell));
+        CHECK(cell == layout_type::unit_cell(layout_type::subgrid_unit(cell), layout_type::subgrid_position(cell)));
+
+        // Each peer shares a unit with the cell, and comes once.
+        std::vector<bool> seen(Side * Side, false);
+        const auto* peers = layout_type::peers(cell);
+        for (unsigned i = 0; i < layout_type::PeerCount; ++i)
+        {
+            const auto peer = peers[i];
+            CHECK(peer != cell);
+            CHECK_FALSE(seen[peer]);
+            seen[peer] = true;
+            CHECK((layout_type::row_unit(peer) == layout_type::row_unit(cell) ||
+                   layout_type::column_unit(peer) == layout_type::column_unit(cell) ||
+                   layout_type::subgrid_unit(peer) == layout_type::subgrid_unit(cell)));
+        }
+    }
+
+    for (unsigned unit = 0; unit < layout_type::UnitCount; ++unit)
+    {
+        const auto* cells = layout_type::unit_cells(unit);
+        for (unsigned i = 1; i < Side; ++i)
+        {
+            CHECK(cells[i - 1] < cells[i]);
+        }
+    }
+}
+
+}
+
+TEST_CASE("grid layout")
+{
+    static_assert(20 == GridLayout::PeerCount, "A 9x9 cell has 20 peers");
+    static_assert(27 == GridLayout::UnitCount, "A 9x9 grid has 27 units");
+    static_assert(2 * 9 + 4 == GridLayout::subgrid_unit(40), "The center cell is in the center subgrid");
+    static_assert(80 == GridLayout::unit_cell(3 * 9 - 1, 8), "The last cell ends the last subgrid");
+
+    check_grid_layout<4>();
+    check_grid_layout<9>();
+    check_grid_layout<16>();
+    check_grid_layout<25>();
+}
+
+TEST_CASE("digit mask")
+{
+    auto mask = DigitMask::all();
+    CHECK(mask.count() == 9);
+    CHECK(mask.lowest() == 1);
+
+    mask.erase(1);
+    mask.erase(DigitMask::single(5) | DigitMask::single(9));
+    CHECK(mask.count() == 6);
+    CHECK(mask.lowest() == 2);
+    CHECK_FALSE(mask.contains(5));
+    CHECK(mask.contains(8));
+
+    CHECK(DigitMask::single(2).is_subset_of(mask));
+    CHECK_FALSE(DigitMask::single(9).is_subset_of(mask));
+    CHECK(and_not(DigitMask::all(), mask) == (DigitMask::single(1) | DigitMask::single(5) | DigitMask::single(9)));
+
+    unsigned sum = 0;
+    for (auto remaining = mask; !remaining.empty(); )
+    {
+        sum += remaining.pop_lowest();
+    }
+    CHECK(sum == 2 + 3 + 4 + 6 + 7 + 8);
+
+    CHECK(sizeof(ConstrainSolver::candidate_grid) == 2 * SudokuGrid::size());
+
+    CHECK(BasicDigitMask<4>::all().bits() == 0xF);
+    CHECK(BasicDigitMask<16>::all().count() == 16);
+    CHECK(BasicDigitMask<25>::all().count() == 25);
+    CHECK(BasicDigitMask<25>::single(25).lowest() == 25);
+    CHECK(sizeof(BasicDigitMask<16>) == 2);
+    CHECK(sizeof(BasicDigitMask<25>) == 4);
+}
+
+TEST_CASE("batch solving")
+{
+    const char* inputFileNames[] = {
+        "../../data/easy_input.txt",
+        "../../data/medium_input.txt",
+        "../../data/hard_input.txt",
+        "../../data/evil_input.txt"
+    };
+
+    std::vector<SudokuGrid> inputs;
+    for (const auto* inputFileName : inputFileNames)
+    {
+        SudokuGrid grid;
+        REQUIRE(fill_from_input_file(inputFileName, grid));
+        inputs.push_back(grid);
+    }
+
+    constexpr auto copies = 50;
+    std::vector<SudokuGrid> grids;
+    for (auto i = 0; i < copies; ++i)
+    {
+        grids.insert(grids.end(), inputs.begin(), inputs.end());
+    }
+
+    const BatchSolver batchSolver(4, 16);
+    const auto results = batchSolver.solve<ConstrainSolver>(grids.data(), grids.size());
+    REQUIRE(results.size() == grids.size());
+
+    for (std::size_t i = 0; i < grids.size(); ++i)
+    {
+        CHECK(results[i].Solved);
+        const auto& input = inputs[i % inputs.size()];
+        CHECK(results[i].InsertedDigits == std::count(input.begin(), input.end(), 0));
+        CHECK(Validator(grids[i]).validate());
+    }
+}
+
+TEST_CASE("reusable solvers")
+{
+    std::vector<SudokuGrid> inputs;
+    for (const auto* inputFileName : { "../../data/easy_input.txt", "../../data/evil_input.txt", "../../data/techniques_input.txt" })
+    {
+        PuzzleReader reader(inputFileName);
+        REQUIRE(reader.read_all(inputs));
+    }
+
+    // A contradiction halfway must not leak into the next grid.
+    auto unsolvable = inputs.front();
+    const auto given = std::find_if(unsolvable.row_begin(0), unsolvable.row_end(0), [](char value) { return !is_empty(value); });
+    const auto empty = std::find(unsolvable.row_begin(0), unsolvable.row_end(0), 0);
+    REQUIRE((given != unsolvable.row_end(0) && empty != unsolvable.row_end(0)));
+    *empty = *given;
+    inputs.insert(inputs.begin() + 1, unsolvable);
+
+    SUBCASE("constrain")
+    {
+        check_reused_solver<ConstrainSolver>(inputs);
+        check_reused_solver<ConstrainSolver>(inputs, TechniqueSet::up_to(Technique::HiddenSingle));
+    }
+
+    SUBCASE("backtracking")
+    {
+        check_reused_solver<BacktrackingSolver>(inputs, BacktrackingSolver::Strategy::MinimumRemainingValues);
+        check_reused_solver<MrvBacktrackingSolver>(inputs);
+    }
+
+    SUBCASE("dlx")
+    {
+        check_reused_solver<DlxSolver>(inputs);
+    }
+
+    SUBCASE("cached")
+    {
+        SolutionCache cache(16);
+        CachedSolver<ConstrainSolver> solver(cache);
+        for (const auto& input : inputs)
+        {
+            auto expected = input;
+            const auto solved = ConstrainSolver(expected).exec();
+
+            SudokuGrid solution;
+            CHECK(solver.solve(input, solution) == solved);
+            CHECK(std::equal(solution.cbegin(), solution.cend(), expected.cbegin()));
+        }
+    }
+
+    SUBCASE("no allocation")
+    {
+        ConstrainSolver solver;
+        SudokuGrid solution;
+        const auto allocationsBefore = allocation_count();
+        for (const auto& input : inputs)
+        {
+            solver.solve(input, solution);
+        }
+        CHECK(allocation_count() == allocationsBefore);
+    }
+}
+
+TEST_CASE("lockstep solving")
+{
+    std::vector<SudokuGrid> inputs;
+    for (const auto* inputFileName : { "../../data/easy_input.txt", "../../data/evil_input.txt", "../../data/techniques_input.txt" })
+    {
+        PuzzleReader reader(inputFileName);
+        REQUIRE(reader.read_all(inputs));
+    }
+
+    // The same given twice in a row.
+    auto unsolvable = inputs.front();
+    const auto given = std::find_if(unsolvable.row_begin(0), unsolvable.row_end(0), [](char value) { return !is_empty(value); });
+    const auto empty = std::find(unsolvable.row_begin(0), unsolvable.row_end(0), 0);
+    REQUIRE((given != unsolvable.row_end(0) && empty != unsolvable.row_end(0)));
+    *empty = *given;
+    inputs.push_back(unsolvable);
+
+    // Not a multiple of the group size.
+    std::vector<SudokuGrid> grids;
+    for (auto i = 0; i < 3; ++i)
+    {
+        grids.insert(grids.end(), inputs.begin(), inputs.end());
+    }
+
+    auto expected = grids;
+    std::vector<BatchResult> expectedResults;
+    for (auto& grid : expected)
+    {
+        ConstrainSolver solver(grid);
+        BatchResult result;
+        result.Solved = solver.exec();
+        result.InsertedDigits = solver.insertedDigits();
+        expectedResults.push_back(result);
+    }
+
+    REQUIRE(std::count_if(expectedResults.cbegin(), expectedResults.cend(), [](const BatchResult& r) { return !r.Solved; }) == 3);
+
+    const auto check_results = [&](const std::vector<SudokuGrid>& solved, const std::vector<BatchResult>& results)
+    {
+        REQUIRE(results.size() == expectedResults.size());
+        for (std::size_t i = 0; i < results.size(); ++i)
+        {
+            CAPTURE(i);
+            CHECK(results[i].Solved == expectedResults[i].Solved);
+            if (expectedResults[i].Solved)
+            {
+                CHECK(results[i].InsertedDigits == expectedResults[i].InsertedDigits);
+                CHECK(std::equal(solved[i].begin(), solved[i].end(), expected[i].begin()));
+            }
+        }
+    };
+
+    const auto best = LockstepSolver::best_instruction_set();
+    for (auto isa : { LockstepSolver::InstructionSet::Scalar, LockstepSolver::InstructionSet::Sse2, LockstepSolver::InstructionSet::Avx2 })
+    {
+        CAPTURE(instruction_set_name(isa));
+        const LockstepSolver solver(isa);
+        CHECK(solver.instructionSet() == std::min(isa, best));
+
+        auto copy = grids;
+        check_results(copy, solver.solve(copy.data(), copy.size()));
+    }
+
+    auto copy = grids;
+    const BatchSolver batchSolver(4, 16);
+    check_results(copy, batchSolver.solve_chunks(LockstepSolver(), copy.data(), copy.size()));
+}
+
+namespace
+{
+
+void write_file(const char* fileName, const char* content)
+{
+    auto* file = fopen(fileName, "w");
+    REQUIRE(nullptr != file);
+    fputs(content, file);
+    fclose(file);
+}
+
+}
+
+TEST_CASE("c interface")
+{
+    CHECK(SUDOKU_ABI_VERSION == sudoku_abi_version());
+
+    std::vector<SudokuGrid> grids;
+    for (const auto* inputFileName : { "../../data/easy_input.txt", "../../data/evil_input.txt", "../../data/techniques_input.txt" })
+    {
+        PuzzleReader reader(inputFileName);
+        REQUIRE(reader.read_all(grids));
+    }
+
+    // The puzzles as text, with '0' and '.' for empty cells, and their
+    // solutions.
+    std::string puzzles;
+    std::string solutions;
+    for (auto& grid : grids)
+    {
+        for (unsigned i = 0; i < SUDOKU_CELLS; ++i)
+        {
+            const auto value = grid[i / 9][i % 9];
+            puzzles += is_empty(value) ? (0 == i % 2 ? '.' : '0') : static_cast<char>('0' + value);
+        }
+
+        REQUIRE(ConstrainSolver(grid).exec());
+        for (const auto value : grid)
+        {
+            solutions += static_cast<char>('0' + value);
+        }
+    }
+
+    auto* ctx = sudoku_ctx_create();
+    REQUIRE(nullptr != ctx);
+
+    SUBCASE("one grid at a time")
+    {
+        for (std::size_t g = 0; g < grids.size(); ++g)
+        {
+            char out[SUDOKU_CELLS] = {};
+            CHECK(SUDOKU_OK == sudoku_solve(puzzles.data() + g * SUDOKU_CELLS, out, ctx));
+            CHECK(std::equal(out, out + SUDOKU_CELLS, solutions.data() + g * SUDOKU_CELLS));
+        }
+    }
+
+    SUBCASE("in place, without allocating")
+    {
+        auto grid = puzzles.substr(0, SUDOKU_CELLS);
+        const auto allocationsBefore = allocation_count();
+        CHECK(SUDOKU_OK == sudoku_solve(grid.data(), &grid[0], ctx));
+        CHECK(allocation_count() == allocationsBefore);
+        CHECK(grid == solutions.substr(0, SUDOKU_CELLS));
+    }
+
+    SUBCASE("batch")
+    {
+        std::string out(puzzles.size(), ' ');
+        std::vector<sudoku_status> statuses(grids.size(), SUDOKU_INVALID_ARGUMENT);
+        CHECK(SUDOKU_OK == sudoku_solve_batch(puzzles.data(), &out[0], grids.size(), statuses.data(), ctx));
+        CHECK(out == solutions);
+        CHECK(std::all_of(statuses.cbegin(), statuses.cend(), [](sudoku_status status) { return SUDOKU_OK == status; }));
+
+        // The first grid which isn't solved tells the result.
+        auto bad = puzzles.substr(0, 3 * SUDOKU_CELLS);
+        bad[SUDOKU_CELLS + 4] = 'x';
+        const auto given = bad.find_first_not_of(".0", 2 * SUDOKU_CELLS);
+        const auto empty = bad.find_first_of(".0", given);
+        REQUIRE(empty < 2 * SUDOKU_CELLS + 9);
+        bad[empty] = bad[given];
+        CHECK(SUDOKU_INVALID_GRID == sudoku_solve_batch(bad.data(), &out[0], 3, statuses.data(), ctx));
+        CHECK(SUDOKU_OK == statuses[0]);
+        CHECK(SUDOKU_INVALID_GRID == statuses[1]);
+        CHECK(SUDOKU_UNSOLVABLE == statuses[2]);
+
+        CHECK(SUDOKU_OK == sudoku_solve_batch(nullptr, nullptr, 0, nullptr, ctx));
+    }
+
+    SUBCASE("errors")
+    {
+        char out[SUDOKU_CELLS] = {};
+        CHECK(SUDOKU_INVALID_ARGUMENT == sudoku_solve(nullptr, out, ctx));
+        CHECK(SUDOKU_INVALID_ARGUMENT == sudoku_solve(puzzles.data(), nullptr, ctx));
+        CHECK(SUDOKU_INVALID_ARGUMENT == sudoku_solve(puzzles.data(), out, nullptr));
+        CHECK(SUDOKU_INVALID_ARGUMENT == sudoku_solve_batch(nullptr, out, 1, nullptr, ctx));
+
+        // A failed solve leaves the output alone.
+        auto invalid = puzzles.substr(0, SUDOKU_CELLS);
+        invalid[40] = ' ';
+        CHECK(SUDOKU_INVALID_GRID == sudoku_solve(invalid.data(), out, ctx));
+        CHECK(std::all_of(out, out + SUDOKU_CELLS, [](char c) { return 0 == c; }));
+
+        CHECK(0 != std::strcmp(sudoku_status_string(SUDOKU_OK), sudoku_status_string(SUDOKU_UNSOLVABLE)));
+    }
+
+    sudoku_ctx_destroy(ctx);
+}
+
+TEST_CASE("puzzle reader")
+{
+    SUBCASE("read grids in different layouts")
+    {
+        constexpr auto fileName = "puzzle_reader_layouts.txt";
+        write_file(fileName,
+            "5.1.6.2.973..2..549..8....7......3..25.....68..7......6....9..341..5..268.9.1.4.5\n"
+            "\n"
+            "5 0 1  0 6 0  2 0 9\n"
+            "7 3 0  0 2 0  0 5 4\n"
+            "9 0 0  8 0 0  0 0 7\n"
+            "\n"
+            "0 0 0  0 0 0  3 0 0\n"
+            "2 5 0  0 0 0  0 6 8\n"
+            "0 0 7  0 0 0  0 0 0\n"
+            "\n"
+            "6 0 0  0 0 9  0 0 3\n"
+            "4 1 0  0 5 0  0 2 6\n"
+            "8 0 9  0 1 0  4 0 5\n");
+
+        PuzzleReader reader(fileName);
+        std::vector<SudokuGrid> grids;
+        REQUIRE(reader.read_all(grids));
+        REQUIRE(grids.size() == 2);
+        CHECK(std::equal(grids[0].cbegin(), grids[0].cend(), grids[1].cbegin()));
+        CHECK(grids[0][0][0] == 5);
+        CHECK(grids[0][0][1] == 0);
+        CHECK(grids[0][8][8] == 5);
+        remove(fileName);
+    }
+
+    SUBCASE("write grids which read back")
+    {
+        BasicSudokuGrid<16> grid;
+        REQUIRE(fill_from_input_file("../../data/16x16_input.txt", grid));
+
+        std::string text;
+        format_grid(grid, false, text);
+        format_grid(grid, true, text);
+        CHECK(text.size() == 16 * 16 + 1 + 16 * (2 * 16) + 1);
+
+        constexpr auto fileName = "puzzle_reader_written.txt";
+        write_file(fileName, text.c_str());
+        PuzzleReader reader(fileName);
+        std::vector<BasicSudokuGrid<16>> grids;
+        REQUIRE(reader.read_all(grids));
+        REQUIRE(grids.size() == 2);
+        CHECK(std::equal(grids[0].cbegin(), grids[0].cend(), grid.cbegin()));
+        CHECK(std::equal(grids[1].cbegin(), grids[1].cend(), grid.cbegin()));
+        remove(fileName);
+    }
+
+    SUBCASE("report the line of invalid characters")
+    {
+        constexpr auto fileName = "puzzle_reader_invalid.txt";
+        write_file(fileName,
+            "5.1.6.2.973..2..549..8....7......3..25.....68..7......6....9..341..5..268.9.1.4.5\n"
+            "5.1.6.2.973..2..549..8....7......3..25..x..68..7......6....9..341..5..268.9.1.4.5\n");
+
+        PuzzleReader reader(fileName);
+        SudokuGrid grid;
+        CHECK(reader.read(grid));
+        CHECK_FALSE(reader.read(grid));
+        CHECK(reader.failed());
+        CHECK(reader.errorLine() == 2);
+        remove(fileName);
+    }
+
+    SUBCASE("report truncated grids")
+    {
+        constexpr auto fileName = "puzzle_reader_truncated.txt";
+        write_file(fileName,
+            "5 0 1  0 6 0  2 0 9\n"
+            "7 3 0  0 2 0  0 5 4\n");
+
+        PuzzleReader reader(fileName);
+        SudokuGrid grid;
+        CHECK_FALSE(reader.read(grid));
+        CHECK(reader.failed());
+        CHECK(reader.errorLine() == 3);
+        remove(fileName);
+    }
+
+    SUBCASE("report lines of the wrong length")
+    {
+        constexpr auto fileName = "puzzle_reader_lines.txt";
+        const char* contents[] = {
+            // Short, then long: the grids would be misaligned.
+            "5.1.6.2.973..2..549..8....7......3..25.....68..7......6....9..341..5..268.9.1.4.5\n"
+            "5.1.6.2.973..2..549..8....7......3..25.....68..7......6....9..341..5..268.9.1.4\n"
+            "5.1.6.2.973..2..549..8....7......3..25.....68..7......6....9..341..5..268.9.1.4.55\n",
+            // A short grid without a line break.
+            "5.1.6.2.973..2..549..8....7......3..25.....68..7......6....9..341..5..268.9.1.4.5\n"
+            "5.1.6.2.973..2..549..8....7",
+            // A grid row one cell short.
+            "5.1.6.2.973..2..549..8....7......3..25.....68..7......6....9..341..5..268.9.1.4.5\n"
+            "5 0 1  0 6 0  2 0 9\n"
+            "7 3 0  0 2 0  0 5\n",
+            // A whole grid in the middle of a spaced one.
+            "5.1.6.2.973..2..549..8....7......3..25.....68..7......6....9..341..5..268.9.1.4.5\n"
+            "5 0 1  0 6 0  2 0 9\n"
+            "5.1.6.2.973..2..549..8....7......3..25.....68..7......6....9..341..5..268.9.1.4.5\n",
+        };
+
+        const unsigned lines[] = { 2, 2, 3, 3 };
+        for (std::size_t i = 0; i < sizeof(lines) / sizeof(lines[0]); ++i)
+        {
+            write_file(fileName, contents[i]);
+
+            PuzzleReader reader(fileName);
+            std::vector<SudokuGrid> grids;
+            CHECK_FALSE(reader.read_all(grids));
+            CHECK(grids.size() == 1);
+            CHECK(reader.errorLine() == lines[i]);
+        }
+
+        remove(fileName);
+    }
+}
+
+TEST_CASE("packed corpus")
+{
+    std::vector<SudokuGrid> puzzles;
+    for (const auto* inputFileName : { "../../data/easy_input.txt", "../../data/evil_input.txt", "../../data/techniques_input.txt" })
+    {
+        PuzzleReader reader(inputFileName);
+        REQUIRE(reader.read_all(puzzles));
+    }
+
+    auto solutions = puzzles;
+    for (auto& solution : solutions)
+    {
+        REQUIRE(ConstrainSolver(solution).exec());
+    }
+
+    SUBCASE("write and map 9x9 grids with their solutions")
+    {
+        constexpr auto fileName = "packed_corpus_solutions.sdk";
+        {
+            PackedCorpusWriter writer(fileName, 9, true);
+            for (std::size_t i = 0; i < puzzles.size(); ++i)
+            {
+                CHECK(writer.write(puzzles[i], &solutions[i]));
+            }
+
+            CHECK_FALSE(writer.write(puzzles[0]));
+            CHECK(writer.failed());
+            CHECK_FALSE(writer.close());
+        }
+
+        {
+            PackedCorpusWriter writer(fileName, 9, true);
+            for (std::size_t i = 0; i < puzzles.size(); ++i)
+            {
+                writer.write(puzzles[i], &solutions[i]);
+            }
+
+            REQUIRE(writer.close());
+        }
+
+        CHECK(is_packed_corpus(fileName));
+        CHECK(9 == detect_grid_side(fileName));
+
+        {
+            const PackedCorpus corpus(fileName);
+            REQUIRE_FALSE(corpus.failed());
+            CHECK(9 == corpus.side());
+            CHECK(corpus.hasSolutions());
+            CHECK(puzzles.size() == corpus.size());
+            CHECK(corpus.records<16>().empty());
+
+            const auto records = corpus.records<9>();
+            REQUIRE(puzzles.size() == records.size());
+            CHECK(records.end() - records.begin() == static_cast<std::ptrdiff_t>(records.size()));
+
+            std::size_t i = 0;
+            for (const auto record : records)
+            {
+                SudokuGrid puzzle;
+                SudokuGrid solution;
+                record.puzzle().unpack(puzzle);
+                record.solution().unpack(solution);
+                CHECK(std::equal(puzzle.cbegin(), puzzle.cend(), puzzles[i].cbegin()));
+                CHECK(std::equal(solution.cbegin(), solution.cend(), solutions[i].cbegin()));
+                CHECK(record.puzzle().cell(8, 8) == puzzles[i][8][8]);
+                ++i;
+            }
+
+            const auto last = records.begin()[static_cast<std::ptrdiff_t>(records.size()) - 1];
+            CHECK(last.solution().cell(4, 5) == solutions.back()[4][5]);
+        }
+
+        std::vector<SudokuGrid> read;
+        std::string errorMessage;
+        REQUIRE(read_puzzles(fileName, read, errorMessage));
+        REQUIRE(read.size() == puzzles.size());
+        CHECK(std::equal(read.back().cbegin(), read.back().cend(), puzzles.back().cbegin()));
+
+        std::vector<BasicSudokuGrid<16>> large;
+        CHECK_FALSE(read_puzzles(fileName, large, errorMessage));
+        remove(fileName);
+    }
+
+    SUBCASE("other grid sizes")
+    {
+        constexpr auto fileName = "packed_corpus_16x16.sdk";
+        BasicSudokuGrid<16> grid;
+        REQUIRE(fill_from_input_file("../../data/16x16_input.txt", grid));
+        {
+            PackedCorpusWriter writer(fileName, 16, false);
+            CHECK(writer.write(grid));
+        }
+
+        const PackedCorpus corpus(fileName);
+        REQUIRE_FALSE(corpus.failed());
+        CHECK(16 == corpus.side());
+        CHECK_FALSE(corpus.hasSolutions());
+        REQUIRE(1 == corpus.size());
+
+        BasicSudokuGrid<16> read;
+        corpus.records<16>()[0].puzzle().unpack(read);
+        CHECK(std::equal(read.cbegin(), read.cend(), grid.cbegin()));
+        remove(fileName);
+    }
+
+    SUBCASE("reject other files")
+    {
+        constexpr auto fileName = "packed_corpus_invalid.sdk";
+        write_file(fileName, "5.1.6.2.973..2..549..8....7......3..25.....68..7......6....9..341..5..268.9.1.4.5\n");
+        CHECK_FALSE(is_packed_corpus(fileName));
+        CHECK(PackedCorpus(fileName).failed());
+
+        // A header which promises more records than there are.
+        const unsigned char header[16] = { 'S', 'D', 'K', 'P', 1, 9, 0, 4, 5 };
+        auto* file = fopen(fileName, "wb");
+        REQUIRE(nullptr != file);
+        fwrite(header, 1, sizeof(header), file);
+        fclose(file);
+        CHECK(is_packed_corpus(fileName));
+        CHECK(PackedCorpus(fileName).failed());
+        remove(fileName);
+
+        CHECK(PackedCorpus("no_such_file.sdk").failed());
+    }
+
+    SUBCASE("reject corrupt cells")
+    {
+        constexpr auto fileName = "packed_corpus_corrupt.sdk";
+        SudokuGrid grid;
+        REQUIRE(fill_from_input_file("../../data/easy_input.txt", grid));
+        {
+            PackedCorpusWriter writer(fileName, 9, false);
+            CHECK(writer.write(grid));
+            CHECK(writer.write(grid));
+        }
+
+        // The low nibble of a cell of the second record becomes 15.
+        auto* file = fopen(fileName, "r+b");
+        REQUIRE(nullptr != file);
+        const long offset = 16 + static_cast<long>(BasicPackedGrid<9>::Size) + 3;
+        fseek(file, offset, SEEK_SET);
+        const auto byte = static_cast<unsigned char>(fgetc(file));
+        fseek(file, offset, SEEK_SET);
+        fputc(byte | 0xF, file);
+        fclose(file);
+
+        {
+            const PackedCorpus corpus(fileName);
+            REQUIRE_FALSE(corpus.failed());
+            SudokuGrid read;
+            CHECK(corpus.records<9>()[0].puzzle().unpack(read));
+            CHECK_FALSE(corpus.records<9>()[1].puzzle().unpack(read));
+        }
+
+        std::vector<SudokuGrid> read;
+        std::string errorMessage;
+        CHECK_FALSE(read_puzzles(fileName, read, errorMessage));
+        CHECK(read.empty());
+        CHECK(std::string::npos != errorMessage.find("record 2"));
+        remove(fileName);
+    }
+}